@@ -38,6 +38,19 @@ proc get_phaseErosion {tsamp wCrossoverFreq} {
                                                                1.0 - (pow($wCrossoverFreq, 2) / (pow($::SwitchingFreq, 2) * 4.0 * pow($tsamp, 2))))}]}
     return $phaseErosionCalc
 }
+#Calculate the total delay in the PWM periods: the digital implementation delay and, for the decimated
+#control loop, the boxcar averaging group delay plus the modulator hold over the decimated sampling period
+proc get_total_delay {} {
+    return [expr {double($::TimeDelay) + ($::FastDiv - 1.0) / 2.0 + ($::FastDiv - 1.0) / 2.0}]
+}
+#Calculate the boxcar averaging magnitude (sinc droop) in dB at the angular frequency
+proc get_boxcar_droop {wFreq} {
+    set x [expr {double($wFreq) / (2.0 * $::SwitchingFreq)}]
+
+    if {($::FastDiv <= 1) || ($x == 0.0)} {set droopCalc 0.0
+    } else {set droopCalc [expr {20.0 * log10(abs(sin($::FastDiv * $x) / ($::FastDiv * sin($x))))}]}
+    return $droopCalc
+}
 proc get_poles_zeros_voltage_mode {l0_inductance c0_capacitance c0_esr lesr} {
     set wResonantFreq [expr {1.0 / sqrt($l0_inductance * $c0_capacitance * ($::RoMaxLoad + $c0_esr) /
                         ($::RoMaxLoad + $lesr))}]
@@ -51,14 +64,15 @@ proc get_poles_zeros_voltage_mode {l0_inductance c0_capacitance c0_esr lesr} {
 
     set wPassiveComponentsZeros [expr {1.0 / ($c0_capacitance * $c0_esr)}]
 
-    set tsamp [expr {$::TimeDelay}]
+    set tsamp [get_total_delay]
 
     set phaseErosion [get_phaseErosion $tsamp $wCrossoverFreq]
 
     set amplitudeCrossoverFreq [expr {20.0 * log10(sqrt(1.0 + pow($wCrossoverFreq / $wPassiveComponentsZeros, 2))) - 
                                       20.0 * log10(sqrt(pow(1.0 - pow($wCrossoverFreq / $wResonantFreq, 2), 2) + 
                                                       pow($wCrossoverFreq/($qualityFactor*$wResonantFreq), 2))) +
-                                      20.0 * log10($::InputNominalVoltage * ($::RoMaxLoad / ($lesr + $::RoMaxLoad)))}]
+                                      20.0 * log10($::InputNominalVoltage * ($::RoMaxLoad / ($lesr + $::RoMaxLoad))) +
+                                      [get_boxcar_droop $wCrossoverFreq]}]
 
     set wPole1 [expr {1.0 / ($c0_capacitance * $c0_esr)}]
 
@@ -203,7 +217,7 @@ proc get_phErosionSimple {CrossoverFreq tsamp} {
     set CrossoverFreq [expr {double($CrossoverFreq)}]
     set tsamp         [expr {double($tsamp)}]
 
-    set phErosionSimpleCalc [expr { -1.0 * 360.0 * $CrossoverFreq / $::SamplFreq * $tsamp}]
+    set phErosionSimpleCalc [expr { -1.0 * 360.0 * $CrossoverFreq / $::SwitchingFreq * $tsamp}]
     return $phErosionSimpleCalc
 }
 
@@ -234,7 +248,7 @@ proc get_poles_zeros_current_mode {l0_inductance c0_capacitance c0_esr lesr} {
 
     set qualityFactor [expr {1.0 / ($::PI * ($mc * $dDash - 0.5))}]
 
-    set tsamp [expr {$::TimeDelay}]
+    set tsamp [get_total_delay]
 
     set phErosionSimple [get_phErosionSimple $::CrossoverFreq $tsamp]
 
@@ -242,7 +256,8 @@ proc get_poles_zeros_current_mode {l0_inductance c0_capacitance c0_esr lesr} {
                      20 * log10(sqrt(1.0 + (pow($wcr, 2) / pow($wz1, 2)))) -
                      20 * log10(sqrt(1.0 + (pow($wcr, 2) / pow($wp1, 2)))) -
                      20 * log10(sqrt(pow(1.0 - (pow($wcr, 2) / pow($wp0, 2)), 2)) +
-                     ((pow($wcr, 2)) / (pow($wp0, 2) * pow($qualityFactor, 2))))}]
+                     ((pow($wcr, 2)) / (pow($wp0, 2) * pow($qualityFactor, 2)))) +
+                     [get_boxcar_droop $wcr]}]
 
     set wZero1 [get_wZero1_Pccm $wcr $fpwm $phErosionSimple $wp1 $qualityFactor $wp0 $::PhaseMargin]
 
@@ -308,7 +323,7 @@ proc get_poles_zeros_current_mode {l0_inductance c0_capacitance c0_esr lesr} {
     while {$maxwCrosFreq - $minwCrosFreq > $tolerance} {
         set crosFreqMid [expr {($maxwCrosFreq + $minwCrosFreq) / 2.0}]
 
-        set phErosionSimpleIter [expr {-1.0 * 360.0 * $crosFreqMid /(2.0 * $::PI * $::SamplFreq) * $tsamp}]
+        set phErosionSimpleIter [expr {-1.0 * 360.0 * $crosFreqMid /(2.0 * $::PI * $::SwitchingFreq) * $tsamp}]
 
         set lastPos_wZero1 [expr {$crosFreqMid / tan(atan2($crosFreqMid / (2.0 * $fpwm), 1.0) -
                                                   $phErosionSimpleIter * $::PI / 180.0 +
@@ -332,7 +347,7 @@ proc get_poles_zeros_current_mode {l0_inductance c0_capacitance c0_esr lesr} {
 
         for {set wcrIter $maxwCrosFreqR} {$wcrIter >= $minwCrosFreqR} {incr wcrIter -$srStep} \
         {
-            set phErosionSimpleIter [expr { -1.0 * 360.0 * $wcrIter /(2.0 * $::PI * $::SamplFreq) * $tsamp}]
+            set phErosionSimpleIter [expr { -1.0 * 360.0 * $wcrIter /(2.0 * $::PI * $::SwitchingFreq) * $tsamp}]
     
             set lastPos_wZero1 [expr { $wcrIter / tan(atan2($wcrIter / (2.0 * $fpwm), 1.0) -
                                                       $phErosionSimpleIter * $::PI / 180.0 +
@@ -351,6 +366,85 @@ proc get_poles_zeros_current_mode {l0_inductance c0_capacitance c0_esr lesr} {
     return [dict create wPole0 $wPole0 wPole1 $wPole1 wPole2 $wPole2 wZero1 $wZero1 wZero2 $wZero2 validMaxPhaseMargin $validMaxPhaseMargin validMaxCrossoverFreq $validMaxCrossoverFreq]
 }
 
+# Multiply two 3x3 matrices
+proc mat3_mul {a b} {
+    set r {}
+    for {set i 0} {$i < 3} {incr i} {
+        set row {}
+        for {set j 0} {$j < 3} {incr j} {
+            set sum 0.0
+            for {set k 0} {$k < 3} {incr k} {
+                set sum [expr {$sum + [lindex $a $i $k] * [lindex $b $k $j]}]
+            }
+            lappend row $sum
+        }
+        lappend r $row
+    }
+    return $r
+}
+# Subtract the scalar from the 3x3 matrix diagonal
+proc mat3_sub_diag {a value} {
+    set r {}
+    for {set i 0} {$i < 3} {incr i} {
+        set row {}
+        for {set j 0} {$j < 3} {incr j} {
+            lappend row [expr {[lindex $a $i $j] - (($i == $j) ? $value : 0.0)}]
+        }
+        lappend r $row
+    }
+    return $r
+}
+#Calculate the load current observer gains (current estimator form, output voltage measured)
+proc get_observer_gains {l0_inductance c0_capacitance lesr} {
+    set obsL0 0.0
+    set obsL1 0.0
+    set obsL2 0.0
+
+    if {$::ObsFreq > 0.0} {
+        set ts [expr {1.0 / $::SamplFreq}]
+        set pole [expr {exp(-2.0 * $::PI * $::ObsFreq * $ts)}]
+
+        if {$::ControlMode == "VOLTAGE"} {
+            # States: inductor current, output voltage, load current; the inductor ESR makes the
+            # inductor and load currents sum observable, its eigenvalue is kept at the natural value
+            set slow [expr {exp(-1.0 * $ts * $lesr / $l0_inductance)}]
+            set a [list [list [expr {1.0 - $ts * $lesr / $l0_inductance}] [expr {-1.0 * $ts / $l0_inductance}] 0.0] \
+                        [list [expr {$ts / $c0_capacitance}] 1.0 [expr {-1.0 * $ts / $c0_capacitance}]] \
+                        [list 0.0 0.0 1.0]]
+            set a2 [mat3_mul $a $a]
+            set a3 [mat3_mul $a2 $a]
+
+            # Observability matrix rows C*A, C*A^2, C*A^3 for C = [0 1 0]
+            lassign [lindex $a 1]  o00 o01 o02
+            lassign [lindex $a2 1] o10 o11 o12
+            lassign [lindex $a3 1] o20 o21 o22
+            set det [expr {$o00 * ($o11 * $o22 - $o12 * $o21) -
+                           $o01 * ($o10 * $o22 - $o12 * $o20) +
+                           $o02 * ($o10 * $o21 - $o11 * $o20)}]
+
+            # The last column of the observability matrix inverse
+            set q0 [expr {($o01 * $o12 - $o02 * $o11) / $det}]
+            set q1 [expr {($o02 * $o10 - $o00 * $o12) / $det}]
+            set q2 [expr {($o00 * $o11 - $o01 * $o10) / $det}]
+
+            # Ackermann's formula with the characteristic polynomial (z - pole)^2 * (z - slow)
+            set n [mat3_sub_diag $a $pole]
+            set phi [mat3_mul [mat3_mul $n $n] [mat3_sub_diag $a $slow]]
+            set gains {}
+            for {set i 0} {$i < 3} {incr i} {
+                lappend gains [expr {[lindex $phi $i 0] * $q0 + [lindex $phi $i 1] * $q1 + [lindex $phi $i 2] * $q2}]
+            }
+            lassign $gains obsL0 obsL1 obsL2
+        } else {
+            # The inductor current is defined by the modulator, only output voltage and load current are estimated
+            set obsL1 [expr {1.0 - $pole * $pole}]
+            set obsL2 [expr {-1.0 * pow(1.0 - $pole, 2) * $c0_capacitance / $ts}]
+        }
+    }
+
+    return [dict create obsL0 $obsL0 obsL1 $obsL1 obsL2 $obsL2]
+}
+
 # From https://wiki.tcl-lang.org/page/constants
 proc const {name value} {
     uplevel 1 [list set $name $value]
@@ -367,6 +461,9 @@ const RESULT_WZERO1 "wZero1"
 const RESULT_WZERO2 "wZero2"
 const RESULT_VALIDPM "validMaxPhaseMargin"
 const RESULT_VALIDWCR "validMaxCrossoverFreq"
+const RESULT_OBSL0 "obsL0"
+const RESULT_OBSL1 "obsL1"
+const RESULT_OBSL2 "obsL2"
 
 # Send data to personality
 proc output_results {result} {
@@ -379,10 +476,13 @@ proc output_results {result} {
     puts $::channelName "param:$::RESULT_WZERO2=[dict get $result wZero2]"
     puts $::channelName "param:$::RESULT_VALIDPM=[dict get $result validMaxPhaseMargin]"
     puts $::channelName "param:$::RESULT_VALIDWCR=[dict get $result validMaxCrossoverFreq]"
+    puts $::channelName "param:$::RESULT_OBSL0=[dict get $result obsL0]"
+    puts $::channelName "param:$::RESULT_OBSL1=[dict get $result obsL1]"
+    puts $::channelName "param:$::RESULT_OBSL2=[dict get $result obsL2]"
 }
 
 # The number of input parameters
-const NUM_OF_ARG 16
+const NUM_OF_ARG 18
 
 # Input parameters
 set ControlMode ""
@@ -401,6 +501,8 @@ set l0_inductance 0
 set c0_capacitance 0
 set c0_esr 0
 set lesr 0
+set ObsFreq 0
+set FastDiv 1
 
 # PI number
 const PI 3.14159265358979
@@ -435,12 +537,16 @@ proc main {} {
     set c0_esr [expr $c0_esr / 1e3]
     set lesr [lindex $::argv 15]
     set lesr [expr $lesr / 1e3]
+    set ::ObsFreq [lindex $::argv 16]
+    set ::FastDiv [lindex $::argv 17]
 
     # Calculate poles and zeros
     if {$::ControlMode == "VOLTAGE"} {set poles_zeros_dict [get_poles_zeros_voltage_mode $l0_inductance $c0_capacitance $c0_esr $lesr]}\
     else {set poles_zeros_dict [get_poles_zeros_current_mode  $l0_inductance $c0_capacitance $c0_esr $lesr]
     }
 
+    set poles_zeros_dict [dict merge $poles_zeros_dict [get_observer_gains $l0_inductance $c0_capacitance $lesr]]
+
     output_results $poles_zeros_dict
 }
 
@@ -40,7 +40,7 @@
 #include <string.h>
 
 /* internal function prototype */
-void mtb_pwrconv_run(mtb_stc_pwrconv_ctx_t * ctx);
+void mtb_pwrconv_run(mtb_stc_pwrconv_t const * inst);
 
 cy_rslt_t mtb_pwrconv_init(mtb_stc_pwrconv_t const * inst)
 {
@@ -48,6 +48,7 @@ cy_rslt_t mtb_pwrconv_init(mtb_stc_pwrconv_t const * inst)
 
     if ((NULL == inst)            ||
         (NULL == inst->ctx)       ||
+        (NULL == inst->cold)      ||
         (NULL == inst->init_hw)   ||
         (NULL == inst->enable_hw) ||
         (NULL == inst->disable_hw))
@@ -57,7 +58,12 @@ cy_rslt_t mtb_pwrconv_init(mtb_stc_pwrconv_t const * inst)
     else
     {
         (void)memset(inst->ctx, 0, sizeof(*inst->ctx));
+        (void)memset(inst->cold, 0, sizeof(*inst->cold));
+        inst->cold->mbox.rampStep = inst->rampStep;
         rslt  = mtb_pwrconv_set_target(inst, inst->targ);
+        mtb_pwrconv_post_limits(inst->cold, mtb_pwrconv_scale_target(inst, inst->targMin),
+                                mtb_pwrconv_scale_target(inst, inst->targMax));
+        (void)mtb_pwrconv_fetch(inst->ctx, inst->cold); /* The control loop is not running yet */
         rslt |= inst->init_hw();
     }
 
@@ -77,14 +83,11 @@ cy_rslt_t mtb_pwrconv_enable(mtb_stc_pwrconv_t const * inst)
 
 
 /* internal function */
-void mtb_pwrconv_run(mtb_stc_pwrconv_ctx_t * ctx)
+void mtb_pwrconv_run(mtb_stc_pwrconv_t const * inst)
 {
-    ctx->state |= MTB_PWRCONV_STATE_RUN;
-
-    if (ctx->ref != ctx->targ)
-    {
-        ctx->state |= MTB_PWRCONV_STATE_RAMP;
-    }
+    /* The RUN and RAMP flags are set by the next ramp call */
+    mtb_pwrconv_post_state(inst->cold, true, false, 0UL);
+    mtb_pwrconv_apply(inst);
 }
 
 
@@ -94,19 +97,84 @@ cy_rslt_t mtb_pwrconv_start(mtb_stc_pwrconv_t const * inst)
 
     if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
     {
-        mtb_pwrconv_run(inst->ctx);
+        mtb_pwrconv_run(inst);
     }
 
     return rslt;
 }
 
 
+/* internal function, should be called when the control loop ISR is stopped */
+static void mtb_pwrconv_stop(mtb_stc_pwrconv_t const * inst)
+{
+    /* The accumulator is not updated anymore */
+    inst->ctx->acc = 0U;
+    inst->ctx->cnt = 0U;
+
+    /* The ramp stops and resets the reference to zero, the request is one store, so any context can post it */
+    mtb_pwrconv_post_stop(inst->cold);
+}
+
+
 cy_rslt_t mtb_pwrconv_disable(mtb_stc_pwrconv_t const * inst)
 {
-    inst->ctx->ref    = 0U;
-    inst->ctx->state &= ~(MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP);
+    cy_rslt_t rslt = inst->disable_hw();
+
+    mtb_pwrconv_stop(inst);
+
+    return rslt;
+}
+
+
+cy_rslt_t mtb_pwrconv_disable_warm(mtb_stc_pwrconv_t const * inst)
+{
+    mtb_stc_pwrconv_ctx_t * ctx = inst->ctx;
+    mtb_stc_pwrconv_cold_t * cold = inst->cold;
+    cy_rslt_t rslt = inst->disable_hw();
+
+    /* The control loop is stopped, so the modulator value is not changed anymore,
+     * the reference and state are not reset until the stop request below is fetched by the ramp
+     */
+    cold->warm.ref   = ctx->ref;
+    cold->warm.mod   = ctx->mod;
+    cold->warm.valid = (0UL != mtb_pwrconv_get_state(inst, MTB_PWRCONV_STATE_RUN)) &&
+                       (MTB_PWRCONV_RSLT_SUCCESS == rslt);
+
+    mtb_pwrconv_stop(inst);
+
+    return rslt;
+}
+
+
+cy_rslt_t mtb_pwrconv_enable_warm(mtb_stc_pwrconv_t const * inst, uint32_t res)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_WARM_FAIL;
+    mtb_stc_pwrconv_ctx_t * ctx = inst->ctx;
+    mtb_stc_pwrconv_cold_t * cold = inst->cold;
+    uint32_t fb  = res << inst->refFrac; /* The feedback in the reference scale */
+    uint32_t dev = (cold->warm.ref > fb) ? (cold->warm.ref - fb) : (fb - cold->warm.ref);
 
-    return inst->disable_hw();
+    if (cold->warm.valid && (NULL != inst->update_hw) && (inst->warmTol >= dev))
+    {
+        /* The reference is restored by the reset request only: the ramp applies it after the pending stop
+         * request of the disabling, so the stop never clears it
+         */
+        mtb_pwrconv_post_state(cold, false, true, cold->warm.ref);
+        mtb_pwrconv_apply(inst);
+
+        /* The control loop ISR is disabled until the HW enabling below, so the modulator is not written
+         * concurrently. The regulator is not re-initialized, it continues from its history.
+         */
+        ctx->mod = cold->warm.mod;
+
+        /* The modulator is pre-charged after the HW enabling, but before the PWM start trigger */
+        rslt  = inst->enable_hw();
+        rslt |= inst->update_hw();
+    }
+
+    cold->warm.valid = false; /* The snapshot is used once */
+
+    return rslt;
 }
 
 
@@ -53,6 +53,17 @@
  * - Basic ramp generator
  * - Pre- and Post-processing user callbacks in the Auto-generated control loop mode
  * - Separately scheduled ADC sequencer group for the slow parameters
+ * - Multi-rate control with averaged feedback decimation
+ * - Load current observer with the load current feedforward
+ * - Relay feedback regulator auto-tuning
+ * - Control loop ISR scheduler for the synchronous start of multiple instances
+ * - Control loop trace recorder with the host replay tool
+ * - Cascaded (multi-loop) control with the PFC line synchronization
+ * - Light-load burst (pulse-skipping) mode
+ * - Deadbeat predictive regulator for PCCM
+ * - Warm restart after short faults
+ * - Inline pipeline stages for the custom control loop
+ * - Hot data placement for the control loop contexts
  *
  * \section section_pwrconv_glossary Glossary
  * - PCC - Power Conversion Configurator
@@ -132,6 +143,32 @@
  * And then in the myCustom.h:
  * \snippet custom/myCustom.h snippet_pwrconv_custom
  *
+ * \subsection subsection_pwrconv_pipe Custom Loop Pipeline
+ * Instead of hand-coding the feedback processing and the modulator limitation in the callback,
+ * the 'Custom loop pipeline' parameter generates the statically composed stages of \ref group_pwrconv_pipe
+ * around the custom control loop callback. All the stages are __STATIC_FORCEINLINE functions
+ * called directly, so with the inline callback the control loop ISR is a straight-line code
+ * without the function pointers:
+ * - the input conditioning - the first Control Loop ADC Group channel is the feedback,
+ * it is optionally filtered by \ref mtb_pwrconv_pipe_filt into \ref mtb_stc_pwrconv_ctx_t::res,
+ * - the error \ref mtb_stc_pwrconv_ctx_t::err is calculated by \ref mtb_pwrconv_get_error,
+ * - the callback is the regulator: it calculates \ref mtb_stc_pwrconv_ctx_t::mod from the error,
+ * e.g. by \ref mtb_pwrconv_2p2z_float_process with the application-defined coefficients,
+ * - the optional feedforward \ref mtb_pwrconv_pipe_ff adds the scaled input,
+ * which the application updates in the generated myPwrConv_pipeFf structure,
+ * - the limiter \ref mtb_pwrconv_pipe_limit limits the output and its slew rate,
+ * - the optional modulator mapping \ref mtb_pwrconv_pipe_map scales the output from the regulator units
+ * into the modulator counts.
+ *
+ * The stages can be used in any other combination by calling them from the callback directly.
+ * The generated myPwrConv_enable() resets the filter to zero (the discharged output) by
+ * \ref mtb_pwrconv_pipe_filt_reset and the limiter slew rate history to its minimum by
+ * \ref mtb_pwrconv_pipe_limit_reset (in the generated myPwrConv_init_reg() function), so the restarted
+ * converter does not continue from the values of the previous run.
+ * \note When the output is pre-charged, the filter should be reset to the present feedback
+ * by \ref mtb_pwrconv_pipe_filt_reset after the enabling and before the start, otherwise the feedback
+ * rises from zero.
+ *
  * \section section_pwrconv_scheduled Scheduled ADC Group
  * To optimize the control loop timing, some ADC measurements can be performed
  * not in the control loop ADC sequencer group, but in the separate scheduled
@@ -158,17 +195,249 @@
  *  comparator reference (DAC slope):
  * \image html PCCM.png
  *
+ * \subsubsection subsection_pwrconv_deadbeat Deadbeat Predictive Regulator
+ * Instead of the 2P2Z regulator, the 'PCCM regulator' parameter (the PCC tool Controller tab) selects
+ * the deadbeat predictive regulator \ref mtb_pwrconv_pred_float_process. As the inner loop makes the inductor
+ * a current source, the output voltage is the output capacitor charged by the difference of the inductor
+ * and load currents. Every control loop period the regulator:
+ * - estimates the load current by the last feedback change and the inductor current applied during that period
+ * (the feedback is passed to the regulator with the error, so the reference changes are not taken for the load),
+ * - predicts the feedback at the end of the current period, where the previously calculated modulator value
+ * is applied,
+ * - calculates the average inductor current, which brings the feedback to the target at the end of the next period,
+ * and converts it into the DAC slope start value by adding the compensation ramp drop and the half inductor ripple.
+ *
+ * The model parameters are calculated by the personality from the 'C0 capacitance', 'L0 inductance',
+ * 'Current sensing gain', the feedback transfer coefficient and the DAC slope. The 'Deadbeat gain' of 1 settles
+ * the error in two periods, the lower values trade the response time for the robustness to the components
+ * tolerances. The load estimation corrects the model inaccuracy, so there is no steady-state error.
+ * \note The regulator is available in the \ref section_pwrconv_infineon mode, without the relay auto-tuning.
+ *
  * \section section_pwrconv_ramp Ramp Generator
  * The PwrConv middleware provides a simple ramp generator -
  * the \ref mtb_pwrconv_ramp function which should be called by a periodical event
  * (e.g. some timer ISR/callback, the timing is important to be determined and stable):
  * \snippet simple/main.c snippet_pwrconv_simple
  * The ramp generator updates the \ref mtb_stc_pwrconv_ctx_t::ref value so that
- * it always moves towards the \ref mtb_stc_pwrconv_ctx_t::targ value with the steps defined by
+ * it always moves towards the \ref mtb_stc_pwrconv_cold_t::targ value with the steps defined by
  * \ref mtb_stc_pwrconv_t::rampStep based on Ramp update period and Ramp slope
  * parameters configurable in the PCC tool:
  * \image html ramp.png
  *
+ * The target millivolts are recalculated into the reference feedback ADC counts by the multiplication and shift
+ * (see \ref mtb_pwrconv_set_target), so the target can be updated frequently.
+ * The targets of several instances can be updated together by \ref mtb_pwrconv_set_targets.
+ *
+ * \subsection section_pwrconv_mailbox Parameter Mailbox
+ * The target and ramping step are not written into the working context directly - the application posts them
+ * into the context mailbox \ref mtb_stc_pwrconv_cold_t::mbox (\ref mtb_pwrconv_set_target,
+ * \ref mtb_pwrconv_set_ramp_step), and the \ref mtb_pwrconv_ramp fetches them at its next call.
+ * The post is protected by the sequence number, which is odd while the mailbox is being written,
+ * so the ramp never takes a half-written update and the interrupts are never disabled.
+ * The target limits (\ref mtb_pwrconv_set_limits) and the run request (\ref mtb_pwrconv_start)
+ * are posted the same way, so the \ref mtb_stc_pwrconv_ctx_t::state flags and the reference are changed
+ * by the ramp only and the updates are not lost. The sequence-numbered part of the mailbox has one writer:
+ * the parameters should be posted from one context (e.g. the main loop or one RTOS task),
+ * and the ramp should be called from one context (e.g. a timer ISR).
+ *
+ * The stop request of \ref mtb_pwrconv_disable and \ref mtb_pwrconv_disable_warm is a separate counter
+ * written by one store, so the disabling can be called from any context, including the protection ISR
+ * preempting the posting one. The ramp applies the stop before the sequence-numbered update: it clears
+ * the state and resets the reference to zero, so disabling and restarting before the next ramp call
+ * still restarts the ramp from zero. The run and reference reset requests posted before a stop request
+ * are dropped, so a fault is never overridden by the preempted start. The pending stop is reported
+ * by \ref mtb_pwrconv_get_state at once, the other state changes - at the next ramp call,
+ * which should be called periodically since the initialization.
+ *
+ * When the application does not call the ramp (the 'Ramp generator' parameter is unchecked,
+ * \ref mtb_stc_pwrconv_t::ramp is zero), e.g. in the \ref section_pwrconv_custom mode,
+ * the posting functions apply the mailbox themselves and the reference steps to the target at once.
+ * The stop request is then applied by the next posting function (typically the restart).
+ * The tools/mbox_stress host tool checks the mailbox with the writer, the ramp and the stopping protection
+ * in concurrent threads.
+ *
+ * \section section_pwrconv_multirate Multi-Rate Control
+ * By default the whole control loop is executed every switching period.
+ * For high switching frequencies this could be unnecessary CPU load, so the
+ * 'Fast Control Loop frequency divider' parameter (the PCC tool Controller tab)
+ * allows to execute the regulator every N switching periods:
+ * - the feedback ADC result is fetched every switching period and accumulated by
+ * the \ref mtb_pwrconv_decimate function, so there is no aliasing of the switching ripple
+ * and the feedback noise into the regulator sampling rate,
+ * - the pre-process callback is called every switching period before the averaging, so the protection checks
+ * in it are not decimated, but the \ref mtb_stc_pwrconv_ctx_t::err value it sees is the one of the previous
+ * regulator execution,
+ * - every N-th period the averaged value is stored into \ref mtb_stc_pwrconv_ctx_t::res and
+ * the error calculation, the post-process callback, the regulator and the modulator update are executed.
+ *
+ * The regulator coefficients are calculated by the personality for the decimated sampling rate.
+ * The 'Time Delay' remains in the switching periods, the averaging group delay and the modulator hold
+ * over the decimated period ((N - 1) / 2 switching periods each) and the averaging magnitude droop
+ * are added to the phase erosion and the crossover gain, so the higher N lowers the achievable crossover frequency.
+ * Also, the \ref myPwrConv_Vout_get_result() function returns the averaged value.
+ *
+ * The averaging of N results gains up to log2(N) bits of the feedback resolution. The
+ * 'Feedback fractional bits' parameter keeps these bits: the averaged feedback, the reference and
+ * the error are scaled by 2^refFrac (see \ref mtb_pwrconv_decimate_frac and \ref mtb_stc_pwrconv_t::refFrac),
+ * the personality scales the regulator gain and the error thresholds accordingly,
+ * and the \ref myPwrConv_Vout_get_result() function still returns the ADC counts.
+ *
+ * \section section_pwrconv_observer Load Current Observer
+ * When the load current is not sensed, it can be estimated by the optional discrete state observer
+ * (the 'Load current observer' parameter, the PCC tool Controller tab). The observer model states are
+ * the total inductor current, the output voltage and the load current (assumed to be constant between the samples).
+ * Every control loop period, before the regulator, the \ref mtb_pwrconv_obs_float_process function predicts
+ * the state from the \ref mtb_stc_pwrconv_ctx_t::mod value applied during the last period and corrects it by
+ * the \ref mtb_stc_pwrconv_ctx_t::res feedback, so the execution time is constant.
+ * The observer gains are calculated by the personality for the 'Observer bandwidth' parameter,
+ * the convergence can be checked on the host against the power stage model by the tools/obs_check tool,
+ * see tools/README.md.
+ *
+ * Optionally, the estimated difference between the load and inductor currents is added to the regulator output
+ * by the \ref mtb_pwrconv_obs_float_feedforward function, which shortens the load transient recovery.
+ * In the steady state this difference is zero, so the feedforward does not shift the regulator operating point.
+ *
+ * The estimation is available for monitoring by the generated myPwrConv_get_load() and
+ * myPwrConv_get_current() functions (in amperes).
+ * \note In VCM the absolute inductor and load currents are observable only via the inductor ESR voltage drop,
+ * therefore their steady-state accuracy depends on the 'L ESR' and nominal input voltage parameters accuracy,
+ * while the load transients (and so the feedforward) are estimated accurately regardless of it.
+ * In PCCM the inductor current is defined by the DAC slope start value,
+ * so the load current estimation accuracy depends on the 'Current sensing gain' parameter.
+ *
+ * \section section_pwrconv_autotune Relay Auto-Tuning
+ * When the 'Relay auto-tuning' parameter is enabled (the PCC tool Controller tab, float regulators only),
+ * the regulator coefficients can be identified on the running converter. The generated myPwrConv_tune_start()
+ * function freezes the regulator and replaces it by the relay with hysteresis around the present
+ * \ref mtb_stc_pwrconv_ctx_t::mod value: the \ref mtb_pwrconv_tune_float_process function switches
+ * the modulator by +/- the 'Relay amplitude' when the error crosses the 'Relay hysteresis' band.
+ * After the settling periods, the limit cycle period and peak-to-peak error are averaged
+ * over the 'Relay measured periods', and the ultimate gain and period are calculated by the describing function.
+ *
+ * The tuning progress is polled by the generated myPwrConv_tune_get_state() function
+ * (\ref MTB_PWRCONV_TUNE_ACTIVE, \ref MTB_PWRCONV_TUNE_DONE or \ref MTB_PWRCONV_TUNE_FAIL on timeout).
+ * When the measurement is done, the generated myPwrConv_tune_apply() function converts the ultimate gain and period
+ * into the PID regulator by the selected 'Tuning rule', re-initializes the regulator with the new coefficients
+ * (the 3P3Z regulator third pole and zero are unused) and returns the control to it bumplessly.
+ * The relay keeps oscillating until then, the measured values are not affected by the polling delay.
+ * The tuning can be checked on the host against the power stage model by the tools/tune_check tool.
+ * On failure it returns \ref MTB_PWRCONV_RSLT_TUNE_FAIL and gives the control back to the regulator
+ * with its original coefficients.
+ * The obtained coefficients are not stored, \ref mtb_pwrconv_tune_float_get_2p2z or
+ * \ref mtb_pwrconv_tune_float_get_3p3z can be used to read them for the PCC tool manual compensation mode.
+ * \note The relay oscillations are visible on the converter output: choose the amplitude small enough
+ * for the application, yet the hysteresis above the feedback noise.
+ *
+ * \section section_pwrconv_burst Light-Load Burst Mode
+ * At light load the switching losses dominate, so the optional burst mode ('Light-load burst mode' parameter,
+ * the PCC tool Controller tab) skips the switching periods. When the \ref mtb_stc_pwrconv_ctx_t::mod value
+ * stays below the 'Burst entry threshold' during the 'Burst entry delay' (and the ramp is not active),
+ * the \ref mtb_pwrconv_burst_process function replaces the regulator by the hysteretic control of
+ * the feedback \ref mtb_stc_pwrconv_ctx_t::res:
+ * - when the feedback falls below the target by the 'Burst lower threshold', the burst starts - the PWM outputs
+ * switch with the fixed 'Burst modulator value',
+ * - when the feedback rises above the target by the 'Burst upper threshold', the burst stops - both PWM outputs
+ * are gated low by the generated myPwrConv_burst_gate() function, while the PWM counters keep running,
+ * - the regulator is not executed, so its history stays frozen at the burst mode entry.
+ *
+ * When the feedback falls below the target by the 'Burst exit threshold', or the burst is longer than
+ * the 'Burst maximal length' (the load is increased), the regulator takes the control back
+ * from its frozen history, so the re-entry into the continuous regulation is bumpless.
+ * The burst mode state is polled by the generated myPwrConv_burst_is_active() function.
+ * \note In VCM with the synchronous rectification the duty cycle barely depends on the load,
+ * so the modulator-based entry is effective in PCCM, where the modulator value is the peak current.
+ * The output voltage ripple in the burst mode is defined by the thresholds and the feedback sampling delay.
+ *
+ * \section section_pwrconv_warm Warm Restart
+ * The \ref mtb_pwrconv_init and \ref mtb_pwrconv_enable functions clear the context and the regulator history,
+ * so after the disabling the output restarts from zero through the full ramp. For the short protective shutdowns
+ * (e.g. an input voltage dip or an over-current trip), the 'Warm restart' parameter (the PCC tool Controller tab)
+ * generates the myPwrConv_disable_warm() and myPwrConv_enable_warm() functions:
+ * - \ref mtb_pwrconv_disable_warm stops the converter and stores the working reference and modulator values
+ * into \ref mtb_stc_pwrconv_cold_t::warm, the regulator context is left intact,
+ * - \ref mtb_pwrconv_enable_warm validates the snapshot by the present output feedback
+ * (the 'Warm restart tolerance' around the stored reference), posts the reference reset to the stored value,
+ * restores the modulator value, enables the HW and pre-charges the modulator by the generated
+ * myPwrConv_update_hw() function, without the regulator re-initialization.
+ *
+ * The reference is restored by the next ramp call (see \ref section_pwrconv_mailbox), so the application
+ * waits for it by \ref mtb_pwrconv_is_applied. The following myPwrConv_start() resumes the regulation from
+ * the last duty cycle (or DAC slope), so the recovery takes a few switching periods. When the output has decayed
+ * too much, \ref MTB_PWRCONV_RSLT_WARM_FAIL is returned and the regular restart is used, for example:
+ * \code
+ * (void)myPwrConv_disable_warm(); // in the protection handler
+ *
+ * if (MTB_PWRCONV_RSLT_SUCCESS != myPwrConv_enable_warm(vout)) // vout is measured after the fault
+ * {
+ *     (void)myPwrConv_enable(); // the cold restart with the ramp from zero
+ * }
+ * else
+ * {
+ *     while (!mtb_pwrconv_is_applied(&myPwrConv)) {} // the next ramp call restores the reference
+ * }
+ * (void)myPwrConv_start();
+ * \endcode
+ * \note The myPwrConv_Vout_get_result() function returns the last control loop feedback,
+ * which is not updated while the converter is disabled, so the output should be measured separately,
+ * e.g. by the \ref section_pwrconv_scheduled channel connected to the output.
+ * Do not call myPwrConv_init() between the warm disabling and enabling, it invalidates the snapshot.
+ *
+ * \section section_pwrconv_trace Control Loop Trace
+ * When the 'Control loop trace' parameter is enabled (the PCC tool Controller tab),
+ * every control loop cycle the \ref mtb_pwrconv_trace_cycle function records the feedback
+ * \ref mtb_stc_pwrconv_ctx_t::res, the modulator \ref mtb_stc_pwrconv_ctx_t::mod and
+ * the changed reference \ref mtb_stc_pwrconv_ctx_t::ref into the RAM ring buffer, so it always keeps the last
+ * cycles. The record is made after the modulator (PWM or DAC) update, so the tracing doesn't add to the control
+ * loop latency. The scheduled channel results and user events are passed to the trace by
+ * \ref mtb_pwrconv_trace_chan and \ref mtb_pwrconv_trace_event (or the generated myPwrConv_trace_event())
+ * from any context without disabling the interrupts - they are recorded by the control loop ISR.
+ * The triggering event (e.g. a protection trip) stops the recording after the 'Post-trigger records',
+ * the generated myPwrConv_disable() and myPwrConv_disable_warm() stop it at once by \ref mtb_pwrconv_trace_stop,
+ * as no more cycles are recorded. Then the trace can be read by \ref mtb_pwrconv_trace_get_header and
+ * \ref mtb_pwrconv_trace_get_rec and replayed on the host by the tools/trace_replay tool, see tools/README.md.
+ *
+ * \section section_pwrconv_cascade Cascaded Control
+ * Topologies like the PFC need two nested loops: the slow outer loop (e.g. the DC-bus voltage)
+ * calculates the reference of the fast inner loop (e.g. the average inductor current).
+ * The \ref mtb_stc_pwrconv_cascade_t structure holds the context of both loops,
+ * each of them with its own \ref mtb_stc_pwrconv_ctx_t and regulator:
+ * - the \ref mtb_pwrconv_cascade_init function pre-calculates the reciprocal of the outer loop decimation factor,
+ * - the \ref mtb_pwrconv_cascade_outer function is called every inner loop period, averages the outer feedback
+ * (by the reciprocal multiplication, without the division) and calculates the outer error every
+ * \ref mtb_stc_pwrconv_cascade_t::div periods,
+ * - when it returns true the outer regulator is executed, its output is the inner loop reference (amplitude),
+ * - the \ref mtb_pwrconv_cascade_inner function calculates the inner error, then the inner regulator
+ * is executed and its output is applied to the modulator.
+ *
+ * For the PFC, the inner reference follows the rectified input voltage shape:
+ * the \ref mtb_pwrconv_pfc_float_line function tracks the line half-cycles by the zero crossing with hysteresis,
+ * validates the line frequency and brown-out, and measures the input voltage mean square once per half-cycle.
+ * The \ref mtb_pwrconv_pfc_float_ref function multiplies the outer loop output by the input voltage
+ * and by the reciprocal mean square (the input voltage RMS feedforward), so the outer loop gain does not depend
+ * on the line voltage. The outer loop should be slow enough (or decimated by the line half-cycle)
+ * to not follow the double line frequency ripple of the DC-bus voltage.
+ *
+ * The cascaded control is implemented in the \ref section_pwrconv_custom mode, for example:
+ * \code
+ * void myPwrConv_custom_callback(void)
+ * {
+ *     uint32_t vin = myPwrConv_Vin_get_result();
+ *
+ *     (void)mtb_pwrconv_pfc_float_line(&myPfc, vin);
+ *     if (mtb_pwrconv_cascade_outer(&myCasc, myPwrConv_Vbus_get_result()))
+ *     {
+ *         (void)mtb_pwrconv_2p2z_float_process(&myVoltReg, myCasc.outer.err, &myCasc.outer.mod);
+ *     }
+ *     (void)mtb_pwrconv_cascade_inner(&myCasc, mtb_pwrconv_pfc_float_ref(&myPfc, myCasc.outer.mod, vin),
+ *                                     myPwrConv_Iind_get_result());
+ *     (void)mtb_pwrconv_2p2z_float_process(&myCurrReg, myCasc.inner.err, &myPwrConv_ctx.mod);
+ * }
+ * \endcode
+ * where myCasc is initialized by mtb_pwrconv_cascade_init(&myCasc, div) before the converter is started.
+ * The cascaded loops can be checked against the boost PFC power stage model by the tools/pfc_check tool,
+ * see tools/README.md.
+ * \note The outer regulator output should be limited to the inner loop reference range.
+ *
  * \section section_pwrconv_syncstart Synchronous Start
  * When there are multiple instances with the same switching frequencies,
  * there might be a need to start them simultaneously with specified phase shift,
@@ -179,6 +448,53 @@
  * instead of regular instance-based [instance_name]_start() functions:
  * \snippet vcmDual/snippet.c snippet_pwrconv_syncstart
  *
+ * Instead of guessing the 'Initial phase' values, they can be calculated by the
+ * \ref mtb_pwrconv_sched_calc scheduler from the control loop ISR periods and worst-case execution times
+ * (the generated myPwrConv_PWM_PERIOD and myPwrConv_ISR_WCET values, the latter is defined by the
+ * 'Control loop ISR execution time' parameter, which should be measured on the target with the final code).
+ * For the \ref section_pwrconv_multirate the scheduler also takes the myPwrConv_FAST_DIV and
+ * myPwrConv_ISR_WCET_LIGHT values (the 'Accumulating ISR execution time' parameter), as the regulator
+ * is executed only every N-th ISR, and the myPwrConv_ISR_DELAY value ('Control loop ISR delay' parameter)
+ * for the instances with different ADC trigger positions.
+ * The scheduler chooses the phases with the largest idle gap between the ISRs of all the instances or
+ * returns \ref MTB_PWRCONV_RSLT_NO_SCHEDULE when the ISRs can't avoid overlapping at any phases
+ * (e.g., for too long ISRs or incommensurate switching periods).
+ * The calculated phases are applied by the generated myPwrConv_set_phase() functions after the instances
+ * are enabled and before the pwrconv_start() call, so the worst-case control loop latency is deterministic.
+ *
+ * \section section_pwrconv_hot Hot Data Placement
+ * The data accessed every control loop period - the \ref mtb_stc_pwrconv_ctx_t context, the regulator,
+ * observer, burst mode and trace contexts - is placed by the linker among the rest of the
+ * application data, so the control loop ISR may wait for the slow memory or compete with the DMA and
+ * other bus masters. The 'Hot data placement' parameter (the PCC tool Controller tab) generates these
+ * variables with the \ref MTB_PWRCONV_HOT attributes: the \ref MTB_PWRCONV_HOT_SECTION linker section,
+ * aligned to \ref MTB_PWRCONV_HOT_ALIGN. The context holds only the fields used by the control loop,
+ * so it fits one aligned block. The ramp, mailbox and warm restart data are in the separate
+ * \ref mtb_stc_pwrconv_cold_t structure (myPwrConv_cold), which is never placed.
+ * The contexts are not packed into one structure, because they are the generated public variables
+ * (myPwrConv_ctx, myPwrConv_regCtx, etc.) used by the application and the middleware functions:
+ * each of them starts its own aligned block in the section, so the hot data of the instance is
+ * the adjacent blocks of the section instead of one block.
+ *
+ * The section should be defined in the linker script, e.g. in the tightly-coupled or zero-wait-state RAM
+ * (the GCC linker script example):
+ * \code
+ * .cy_pwrconv_hot (NOLOAD) : ALIGN(32)
+ * {
+ *     KEEP(*(.cy_pwrconv_hot))
+ * } > ram
+ * \endcode
+ * The section name can be changed by the MTB_PWRCONV_HOT_SECTION compiler definition
+ * (e.g. DEFINES+=MTB_PWRCONV_HOT_SECTION=\".dtcm\" in the application Makefile) to use the existing
+ * section of the device linker script. The section is not initialized at the startup (NOLOAD),
+ * the placed contexts are initialized by the myPwrConv_init() and myPwrConv_enable() functions.
+ * The auto-tuning context and the custom loop pipeline stages rely on the static initialization,
+ * so they are not placed.
+ * The generated myPwrConv_HOT_SIZE macro returns the total size of the placed data of the instance
+ * including the alignment padding of every variable (see \ref MTB_PWRCONV_HOT_SIZEOF),
+ * to check it against the section size. The tools/hot_size host tool reports the same sizes
+ * for the configuration options before the personality is configured, see tools/README.md.
+ *
  * \section section_pwrconv_multiphase Multi-Phase
  * The multiple interleaved conversion phases allows to divide a total power between multiple parallel
  * power circuits (switches, inductors) for better heat dissipation, reliability,
@@ -194,6 +510,7 @@
  *   \defgroup group_pwrconv_status Status
  *   \defgroup group_pwrconv_states States
  *   \defgroup group_pwrconv_types Types
+ *   \defgroup group_pwrconv_memory Memory Layout
  * \}
  * \defgroup group_pwrconv_data_structures Data Structures
  * \defgroup group_pwrconv_func_types Function Type Definitions
@@ -205,6 +522,7 @@
 #define MTB_PWRCONV_H
 
 #include "cy_pdl.h"
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -216,12 +534,18 @@ extern "C" {
 #define MTB_PWRCONV_RSLT_SUCCESS          CY_RSLT_SUCCESS
 /** Return the Power Conversion operation status of type cy_rslt_t: invalid input parameter */
 #define MTB_PWRCONV_RSLT_INVALID_PARAM    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_PWRCONV, 1UL)
+/** Return the Power Conversion operation status of type cy_rslt_t: the auto-tuning is not completed or failed */
+#define MTB_PWRCONV_RSLT_TUNE_FAIL        CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_PWRCONV, 2UL)
+/** Return the Power Conversion operation status of type cy_rslt_t: the control loop ISRs always overlap */
+#define MTB_PWRCONV_RSLT_NO_SCHEDULE      CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_PWRCONV, 3UL)
+/** Return the Power Conversion operation status of type cy_rslt_t: the warm restart snapshot is not valid */
+#define MTB_PWRCONV_RSLT_WARM_FAIL        CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_PWRCONV, 4UL)
 /** \} group_pwrconv_status */
 
 /** \addtogroup group_pwrconv_types
  *  \{ */
 #define MTB_PWRCONV_BUCK (0U) /**< The Buck power converter */
-#define MTB_PWRCONV_PFC  (1U) /**< The PFC power converter (for future capability) */
+#define MTB_PWRCONV_PFC  (1U) /**< The PFC power converter, see \ref section_pwrconv_cascade */
 /** \} group_pwrconv_types */
 
 /** \addtogroup group_pwrconv_states
@@ -239,6 +563,27 @@ extern "C" {
                                                      */
 /** \} group_pwrconv_states */
 
+/** \addtogroup group_pwrconv_memory
+ *  \{ */
+#ifndef MTB_PWRCONV_HOT_SECTION
+/** The linker section name for the control loop hot data, can be overridden by the compiler command line
+ *  definition, see \ref section_pwrconv_hot
+ */
+#define MTB_PWRCONV_HOT_SECTION      ".cy_pwrconv_hot"
+#endif
+/** The control loop hot data alignment - the bus burst or cache line size in bytes */
+#define MTB_PWRCONV_HOT_ALIGN        (32U)
+/** The control loop hot data placement attributes */
+#define MTB_PWRCONV_HOT              CY_SECTION(MTB_PWRCONV_HOT_SECTION) CY_ALIGN(MTB_PWRCONV_HOT_ALIGN)
+/** The size of the hot data object rounded up to \ref MTB_PWRCONV_HOT_ALIGN - its footprint in the section */
+#define MTB_PWRCONV_HOT_SIZEOF(obj)  \
+    ((sizeof(obj) + (MTB_PWRCONV_HOT_ALIGN - 1U)) & ~((size_t)MTB_PWRCONV_HOT_ALIGN - 1U))
+/** \cond INTERNAL */
+/** The compile-time check, C99-compatible */
+#define MTB_PWRCONV_STATIC_ASSERT(cond, name) typedef char mtb_pwrconv_assert_##name[(cond) ? 1 : -1]
+/** \endcond */
+/** \} group_pwrconv_memory */
+
 
 
 /** \addtogroup group_pwrconv_func_types
@@ -257,10 +602,48 @@ typedef cy_rslt_t (* mtb_func_pwrconv_t) (void);
  * \{
  */
 
-/** The context data structure */
+/** The parameter mailbox structure - the lock-free (sequence-numbered) channel from the application
+ *  to the \ref mtb_pwrconv_ramp() function, see \ref section_pwrconv_mailbox.
+ */
+typedef struct
+{
+    volatile uint32_t seq; /**< The update sequence number, odd while the application is writing the mailbox */
+    uint32_t      ack; /**< The last fetched sequence number */
+    uint32_t     targ; /**< The posted target reference value */
+    uint32_t rampStep; /**< The posted reference ramping step */
+    uint32_t   refMin; /**< The posted minimal reference value, the target is limited by it */
+    uint32_t   refMax; /**< The posted maximal reference value, the target is limited by it */
+    uint32_t      run; /**< The posted state request: non-zero to run, zero to stop */
+    uint32_t    reset; /**< The posted reference reset request counter, incremented by every request */
+    uint32_t   resRef; /**< The posted reference value applied by the reset request */
+    uint32_t   resAck; /**< The last applied reference reset request counter */
+    uint32_t      gen; /**< The stop request counter at the state request posting, the run and reset
+                        *   requests are dropped when a stop request follows them
+                        */
+    volatile uint32_t stop; /**< The stop request counter, written by one store out of the sequence number */
+    uint32_t  stopAck; /**< The last applied stop request counter */
+} mtb_stc_pwrconv_mbox_t;
+
+
+/** The warm restart snapshot structure, taken by the \ref mtb_pwrconv_disable_warm() function,
+ *  see \ref section_pwrconv_warm.
+ */
+typedef struct
+{
+    uint32_t   ref; /**< The working reference value at the disabling */
+    uint32_t   mod; /**< The modulator value at the disabling */
+    bool     valid; /**< The snapshot is taken from the running converter and not used yet */
+} mtb_stc_pwrconv_warm_t;
+
+
+/** The context data structure
+ *
+ * Only the fields accessed every control loop period, so the context fits one
+ * \ref MTB_PWRCONV_HOT_ALIGN block, see \ref section_pwrconv_hot.
+ * The rest of the live data is in the \ref mtb_stc_pwrconv_cold_t.
+ */
 typedef struct
 {
-    uint32_t  targ; /**< The desired target reference value, updated by the \ref mtb_pwrconv_set_target() function. */
     uint32_t   ref; /**< The current working reference value, updated by the \ref mtb_pwrconv_ramp() function. */
     uint32_t   res; /**< The measured result, the intermediate value, being copied from the ADC result register by
                      *   generated FW or by the DMA and then being used to calculate the error value and also being used
@@ -272,11 +655,40 @@ typedef struct
                      *   and then copied into PWM or DAC within the generated ISR,
                      *   common for all interleaved phases.
                      */
+    uint32_t   acc; /**< The feedback accumulator for the \ref section_pwrconv_multirate,
+                     *   updated by the \ref mtb_pwrconv_decimate() function.
+                     */
+    uint32_t   cnt; /**< The number of feedback samples accumulated in \ref mtb_stc_pwrconv_ctx_t::acc */
     uint32_t state; /**< The converter state/status flags \ref group_pwrconv_states,
                      *   typically accessed by \ref mtb_pwrconv_get_state() in user code.
                      */
 } mtb_stc_pwrconv_ctx_t;
 
+/** \cond INTERNAL */
+MTB_PWRCONV_STATIC_ASSERT((offsetof(mtb_stc_pwrconv_ctx_t, state) + sizeof(uint32_t)) <= MTB_PWRCONV_HOT_ALIGN,
+                          ctx_hot_fields);
+MTB_PWRCONV_STATIC_ASSERT(sizeof(mtb_stc_pwrconv_ctx_t) == (offsetof(mtb_stc_pwrconv_ctx_t, state) + sizeof(uint32_t)),
+                          ctx_hot_only);
+/** \endcond */
+
+
+/** The cold context data structure
+ *
+ * The live data not accessed by the control loop ISR: the ramp, mailbox and warm restart data,
+ * kept out of the \ref section_pwrconv_hot.
+ */
+typedef struct
+{
+    uint32_t  targ; /**< The desired target reference value, fetched from the \ref mtb_stc_pwrconv_cold_t::mbox
+                     *   (posted by the \ref mtb_pwrconv_set_target() function) by the \ref mtb_pwrconv_ramp().
+                     */
+    uint32_t rampStep; /**< The reference ramping step, fetched from the \ref mtb_stc_pwrconv_cold_t::mbox
+                        *   (posted by the \ref mtb_pwrconv_set_ramp_step() function) by the \ref mtb_pwrconv_ramp().
+                        */
+    mtb_stc_pwrconv_mbox_t mbox; /**< The parameter mailbox */
+    mtb_stc_pwrconv_warm_t warm; /**< The warm restart snapshot */
+} mtb_stc_pwrconv_cold_t;
+
 
 /** The instance structure,
  *  which includes all the instance-specific settings:
@@ -284,27 +696,24 @@ typedef struct
  */
 typedef struct
 {
-    uint8_t       type; /**< The converter type/topology, \ref group_pwrconv_types */
-
     /* Reference */
     uint32_t      targ; /**< The initial target value */
     uint32_t   targMax; /**< The maximal acceptable target value, in millivolts */
     uint32_t   targMin; /**< The minimal acceptable target value, in millivolts */
-    uint16_t    refNum; /**< The numerator for reference calculation,
-                         *   equals to the channel gain (internal and external) * ADC resolution,
-                         *   used by the \ref mtb_pwrconv_set_target to recalculate the target millivolts
-                         *   into the reference ADC counts in the \ref section_pwrconv_infineon mode.
-                         */
-    uint16_t    refDen; /**< The denominator for reference calculation,
-                         *   equals to the ADC reference voltage in millivolts,
+    uint32_t    refMul; /**< The fixed-point multiplier for reference calculation,
+                         *   equals to the channel gain (internal and external) * ADC resolution
+                         *   divided by the ADC reference voltage in millivolts and scaled by 2^refShift,
                          *   used by the \ref mtb_pwrconv_set_target to recalculate the target millivolts
                          *   into the reference ADC counts in the \ref section_pwrconv_infineon mode.
                          */
     /* Ramp */
-    uint16_t  rampStep; /**< The reference update ramping step, must be positive and non-zero */
+    uint32_t  rampStep; /**< The initial reference update ramping step, must be positive and non-zero */
 
     /* RAM context */
     mtb_stc_pwrconv_ctx_t * ctx; /**< The pointer to the context RAM structure with converter live data */
+    mtb_stc_pwrconv_cold_t * cold; /**< The pointer to the cold context RAM structure:
+                                    *   the ramp, mailbox and warm restart data
+                                    */
 
     /* Regulator */
     mtb_func_pwrconv_t init_reg; /**< The pointer to the topology-specific regulator initialization function */
@@ -314,7 +723,32 @@ typedef struct
     mtb_func_pwrconv_t    init_hw; /**< The pointer to the topology-specific HW initialization function */
     mtb_func_pwrconv_t  enable_hw; /**< The pointer to the topology-specific HW enabling function */
     mtb_func_pwrconv_t disable_hw; /**< The pointer to the topology-specific HW disabling function */
+    mtb_func_pwrconv_t  update_hw; /**< The pointer to the modulator update function for the warm restart,
+                                    *   NULL when the warm restart is not used
+                                    */
+    uint32_t          warmTol; /**< The maximal feedback deviation from the snapshot reference,
+                                *   accepted by the \ref mtb_pwrconv_enable_warm(), in feedback ADC counts
+                                *   scaled by 2^\ref mtb_stc_pwrconv_t::refFrac
+                                */
+
+    /* The byte-sized fields are grouped to avoid the padding */
+    uint8_t       type; /**< The converter type/topology, \ref group_pwrconv_types */
+    uint8_t   refShift; /**< The right shift of the target by \ref mtb_stc_pwrconv_t::refMul product,
+                         *   replaces the division in the reference calculation, up to 32.
+                         */
+    uint8_t    refFrac; /**< The number of the fractional bits of the reference and feedback values,
+                         *   see the \ref section_pwrconv_multirate, zero when the feedback is in the ADC counts.
+                         */
+    uint8_t       ramp; /**< Non-zero when the application calls \ref mtb_pwrconv_ramp periodically,
+                         *   zero when the posting functions apply the mailbox themselves,
+                         *   see \ref section_pwrconv_mailbox.
+                         */
 } mtb_stc_pwrconv_t;
+
+/** \cond INTERNAL */
+MTB_PWRCONV_STATIC_ASSERT(offsetof(mtb_stc_pwrconv_t, type) ==
+                          (offsetof(mtb_stc_pwrconv_t, warmTol) + sizeof(uint32_t)), inst_no_padding);
+/** \endcond */
 /** \} group_pwrconv_data_structures */
 
 
@@ -349,7 +783,9 @@ cy_rslt_t mtb_pwrconv_enable(mtb_stc_pwrconv_t const * inst);
 
 /** Starts the Power Conversion Control System.
  *
- * This function triggers the synchronous start of the Power Conversion PWM(s)
+ * This function triggers the synchronous start of the Power Conversion PWM(s) and posts the run request,
+ * the \ref MTB_PWRCONV_STATE_RUN state is set by the next \ref mtb_pwrconv_ramp call
+ * (at once when \ref mtb_stc_pwrconv_t::ramp is zero), see \ref section_pwrconv_mailbox.
  *
  * @param[in] inst The pointer to the power converter instance structure.
  *
@@ -362,15 +798,54 @@ cy_rslt_t mtb_pwrconv_start(mtb_stc_pwrconv_t const * inst);
 /** Disables (stops) the Power Conversion Control System.
  *
  * This function disables (stops) the Power Conversion components: stops PWM(s) and DAC(s) (if used),
- * and disables ADC interrupts.
+ * and disables ADC interrupts. The stop request is posted by one store, so this function can be called from
+ * the protection ISR. The state and reference are cleared by the next \ref mtb_pwrconv_ramp call
+ * (by the next posting function when \ref mtb_stc_pwrconv_t::ramp is zero), see \ref section_pwrconv_mailbox.
  *
  * @param[in] inst The pointer to the power converter instance structure
- * @return         The result of the function operation \ref group_pwrconv_status
- *                 Currently it returns always \ref MTB_PWRCONV_RSLT_SUCCESS, for future capabilities.
+ * @return         The result of the HW disabling by \ref mtb_stc_pwrconv_t::disable_hw,
+ *                 see \ref group_pwrconv_status.
  */
 cy_rslt_t mtb_pwrconv_disable(mtb_stc_pwrconv_t const * inst);
 
 
+/** Disables (stops) the Power Conversion Control System keeping the warm restart snapshot.
+ *
+ * This function disables the HW first, then, when the converter was running, stores the working reference
+ * and modulator values into \ref mtb_stc_pwrconv_cold_t::warm, and then posts the stop request
+ * like \ref mtb_pwrconv_disable.
+ * The regulator context is not changed while the control loop is stopped, so its history is kept as well.
+ * Typically called by the protection handler on the short faults, see \ref section_pwrconv_warm.
+ *
+ * @param[in] inst The pointer to the power converter instance structure
+ * @return         The result of the HW disabling by \ref mtb_stc_pwrconv_t::disable_hw,
+ *                 see \ref group_pwrconv_status. The snapshot is valid only when it is
+ *                 \ref MTB_PWRCONV_RSLT_SUCCESS.
+ */
+cy_rslt_t mtb_pwrconv_disable_warm(mtb_stc_pwrconv_t const * inst);
+
+
+/** Enables the Power Conversion Control System from the warm restart snapshot.
+ *
+ * When the snapshot is valid and the present feedback deviates from the snapshot reference by
+ * not more than \ref mtb_stc_pwrconv_t::warmTol, this function posts the reference reset to the snapshot value,
+ * restores the modulator value (the control loop ISR is disabled yet), enables the HW and pre-charges
+ * the modulator by \ref mtb_stc_pwrconv_t::update_hw without the regulator re-initialization.
+ * The reference is restored by the next \ref mtb_pwrconv_ramp call, after it (see \ref mtb_pwrconv_is_applied)
+ * the \ref mtb_pwrconv_start resumes the regulation without the ramp from zero. The snapshot is used once.
+ *
+ * Otherwise, nothing is enabled: the application should restart by \ref mtb_pwrconv_enable.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ * @param[in] res  The present feedback value, measured after the fault, in feedback ADC counts.
+ * @return         The result of the function operation \ref group_pwrconv_status
+ *                 - \ref MTB_PWRCONV_RSLT_SUCCESS - the converter is enabled from the snapshot,
+ *                 - \ref MTB_PWRCONV_RSLT_WARM_FAIL - the snapshot is not valid, the output voltage is
+ *                   too far from it or the warm restart is not configured.
+ */
+cy_rslt_t mtb_pwrconv_enable_warm(mtb_stc_pwrconv_t const * inst, uint32_t res);
+
+
 /**
  * Returns the state of a Power Conversion Control System instance.
  *
@@ -380,24 +855,259 @@ cy_rslt_t mtb_pwrconv_disable(mtb_stc_pwrconv_t const * inst);
  */
 __STATIC_INLINE uint32_t mtb_pwrconv_get_state(mtb_stc_pwrconv_t const * inst, uint32_t mask)
 {
-    return (inst->ctx->state & mask);
+    uint32_t state = inst->ctx->state;
+
+    if (inst->cold->mbox.stop != inst->cold->mbox.stopAck)
+    {
+        /* The converter is already stopped, the pending stop request only clears the flags */
+        state &= ~(MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP);
+    }
+
+    return (state & mask);
+}
+
+
+/** Posts the parameters into the mailbox \ref mtb_stc_pwrconv_cold_t::mbox.
+ *
+ * The parameters are written between two sequence number increments without disabling the interrupts,
+ * so the \ref mtb_pwrconv_fetch() never takes a partially written update.
+ * Should be called from one context only (e.g. the main loop),
+ * typically via \ref mtb_pwrconv_set_target or \ref mtb_pwrconv_set_ramp_step.
+ *
+ * @param[in] cold     The pointer to the power converter instance cold context structure.
+ * @param[in] targ     The target reference value.
+ * @param[in] rampStep The reference ramping step.
+ */
+__STATIC_INLINE void mtb_pwrconv_post(mtb_stc_pwrconv_cold_t * cold, uint32_t targ, uint32_t rampStep)
+{
+    cold->mbox.seq++; /* Odd: the update is in progress */
+    __DMB();
+    cold->mbox.targ     = targ;
+    cold->mbox.rampStep = rampStep;
+    __DMB();
+    cold->mbox.seq++; /* Even: the update is complete */
+}
+
+
+/** Posts the reference limits into the mailbox \ref mtb_stc_pwrconv_cold_t::mbox.
+ *
+ * The target fetched by the \ref mtb_pwrconv_fetch() is limited by these values,
+ * typically posted via \ref mtb_pwrconv_set_limits. Should be called from the same context
+ * as \ref mtb_pwrconv_post.
+ *
+ * @param[in] cold   The pointer to the power converter instance cold context structure.
+ * @param[in] refMin The minimal reference value.
+ * @param[in] refMax The maximal reference value.
+ */
+__STATIC_INLINE void mtb_pwrconv_post_limits(mtb_stc_pwrconv_cold_t * cold, uint32_t refMin, uint32_t refMax)
+{
+    cold->mbox.seq++; /* Odd: the update is in progress */
+    __DMB();
+    cold->mbox.refMin = refMin;
+    cold->mbox.refMax = refMax;
+    __DMB();
+    cold->mbox.seq++; /* Even: the update is complete */
+}
+
+
+/** Posts the state request into the mailbox \ref mtb_stc_pwrconv_cold_t::mbox.
+ *
+ * The \ref MTB_PWRCONV_STATE_RUN flag is set or cleared by the next \ref mtb_pwrconv_fetch() call,
+ * so the application never modifies the \ref mtb_stc_pwrconv_ctx_t::state.
+ * The request is dropped when \ref mtb_pwrconv_post_stop() follows it before the fetch.
+ * Typically posted by \ref mtb_pwrconv_start and \ref mtb_pwrconv_enable_warm.
+ * Should be called from the same context as \ref mtb_pwrconv_post.
+ *
+ * @param[in] cold   The pointer to the power converter instance cold context structure.
+ * @param[in] run    True to run, false to stop.
+ * @param[in] reset  True to reset the reference (stopping the converter), false to keep it.
+ * @param[in] ref    The reference value applied by the reset request.
+ */
+__STATIC_INLINE void mtb_pwrconv_post_state(mtb_stc_pwrconv_cold_t * cold, bool run, bool reset, uint32_t ref)
+{
+    cold->mbox.seq++; /* Odd: the update is in progress */
+    __DMB();
+    cold->mbox.run = run ? 1UL : 0UL;
+    cold->mbox.gen = cold->mbox.stop;
+    if (reset)
+    {
+        cold->mbox.resRef = ref;
+        cold->mbox.reset++; /* Counted, so the reset is not lost when the run is requested before the fetch */
+    }
+    __DMB();
+    cold->mbox.seq++; /* Even: the update is complete */
+}
+
+
+/** Posts the stop request into the mailbox \ref mtb_stc_pwrconv_cold_t::mbox.
+ *
+ * The next \ref mtb_pwrconv_fetch() call clears the \ref MTB_PWRCONV_STATE_RUN and
+ * \ref MTB_PWRCONV_STATE_RAMP flags, resets the reference to zero and drops the state requests posted before.
+ * The request counter is written by one store and is not protected by the sequence number, so this function
+ * can be called from any context, e.g. from the protection ISR preempting \ref mtb_pwrconv_post.
+ * The counter is set above both the posted and the applied values, so it differs from them even when
+ * the store of the preempted context is stale. The concurrent stop requests merge into one.
+ * Typically posted by \ref mtb_pwrconv_disable.
+ *
+ * @param[in] cold   The pointer to the power converter instance cold context structure.
+ */
+__STATIC_INLINE void mtb_pwrconv_post_stop(mtb_stc_pwrconv_cold_t * cold)
+{
+    uint32_t stop = cold->mbox.stop;
+    uint32_t ack  = cold->mbox.stopAck;
+
+    __DMB(); /* The data written before the request, e.g. the warm restart snapshot, is visible to the fetch */
+    cold->mbox.stop = ((stop > ack) ? stop : ack) + 1UL;
+}
+
+
+/** Fetches the parameters posted into the mailbox \ref mtb_stc_pwrconv_cold_t::mbox.
+ *
+ * The pending stop request is applied first: the \ref MTB_PWRCONV_STATE_RUN and \ref MTB_PWRCONV_STATE_RAMP
+ * flags are cleared and the reference is reset to zero.
+ * The update is taken only when it is complete and consistent, otherwise it is left for the next call.
+ * The target is limited by the posted reference limits, the posted reference reset is applied
+ * and the \ref MTB_PWRCONV_STATE_RUN and \ref MTB_PWRCONV_STATE_RAMP flags are updated,
+ * unless a stop request is posted after them, so the reference and state are changed by one context only.
+ * Called by \ref mtb_pwrconv_ramp, so should not be called concurrently with it.
+ *
+ * @param[in] ctx  The pointer to the power converter instance context structure.
+ * @param[in] cold The pointer to the power converter instance cold context structure.
+ * @return         True when the stop request or the new parameters are fetched.
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_fetch(mtb_stc_pwrconv_ctx_t * ctx, mtb_stc_pwrconv_cold_t * cold)
+{
+    bool rdy = false;
+    uint32_t stop = cold->mbox.stop;
+    uint32_t seq = cold->mbox.seq;
+
+    if (stop != cold->mbox.stopAck)
+    {
+        __DMB();
+        ctx->state &= ~(MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP);
+        ctx->ref = 0UL;
+        cold->mbox.stopAck = stop;
+        rdy = true;
+    }
+
+    if ((0UL == (seq & 1UL)) && (seq != cold->mbox.ack))
+    {
+        uint32_t targ;
+        uint32_t rampStep;
+        uint32_t refMin;
+        uint32_t refMax;
+        uint32_t run;
+        uint32_t reset;
+        uint32_t resRef;
+        uint32_t gen;
+
+        __DMB();
+        targ     = cold->mbox.targ;
+        rampStep = cold->mbox.rampStep;
+        refMin   = cold->mbox.refMin;
+        refMax   = cold->mbox.refMax;
+        run      = cold->mbox.run;
+        reset    = cold->mbox.reset;
+        resRef   = cold->mbox.resRef;
+        gen      = cold->mbox.gen;
+        __DMB();
+
+        if (seq == cold->mbox.seq) /* Not overwritten meanwhile, e.g. from another core */
+        {
+            uint32_t state = ctx->state & ~(MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP);
+            bool cur = (gen == stop); /* The state request is not followed by the stop request */
+
+            if (reset != cold->mbox.resAck)
+            {
+                ctx->ref = cur ? resRef : ctx->ref;
+                cold->mbox.resAck = reset;
+            }
+
+            cold->targ     = (targ > refMax) ? refMax : ((targ < refMin) ? refMin : targ);
+            cold->rampStep = rampStep;
+            cold->mbox.ack = seq;
+            rdy = true;
+
+            if (cur && (0UL != run))
+            {
+                state |= (ctx->ref != cold->targ) ? (MTB_PWRCONV_STATE_RUN | MTB_PWRCONV_STATE_RAMP) :
+                                                   MTB_PWRCONV_STATE_RUN;
+            }
+
+            ctx->state = state;
+        }
+    }
+
+    return rdy;
+}
+
+
+/** Applies the posted parameters at once when the application does not call \ref mtb_pwrconv_ramp
+ *  (\ref mtb_stc_pwrconv_t::ramp is zero): fetches the mailbox and steps the running reference to the target.
+ *  Called by the posting functions, does nothing when the ramp generator is used.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ */
+__STATIC_INLINE void mtb_pwrconv_apply(mtb_stc_pwrconv_t const * inst)
+{
+    mtb_stc_pwrconv_ctx_t * ctx = inst->ctx;
+    mtb_stc_pwrconv_cold_t * cold = inst->cold;
+
+    if (0U == inst->ramp)
+    {
+        (void)mtb_pwrconv_fetch(ctx, cold);
+        if (0UL != (ctx->state & MTB_PWRCONV_STATE_RUN))
+        {
+            ctx->ref    = cold->targ;
+            ctx->state &= ~MTB_PWRCONV_STATE_RAMP;
+        }
+    }
+}
+
+
+/** Checks that the parameters and requests posted so far are applied by \ref mtb_pwrconv_fetch,
+ *  e.g. the reference is restored by \ref mtb_pwrconv_enable_warm before the start.
+ *  Should be called from the posting context, see \ref section_pwrconv_mailbox.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ * @return         True when the mailbox has no pending updates.
+ */
+__STATIC_INLINE bool mtb_pwrconv_is_applied(mtb_stc_pwrconv_t const * inst)
+{
+    return (inst->cold->mbox.seq == inst->cold->mbox.ack) && (inst->cold->mbox.stop == inst->cold->mbox.stopAck);
+}
+
+
+/** Recalculates the target value into the reference units by the fixed-point multiplication
+ *  \ref mtb_stc_pwrconv_t::refMul and right shift \ref mtb_stc_pwrconv_t::refShift.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ * @param[in] targ The target value, in millivolts in the \ref section_pwrconv_infineon mode.
+ * @return         The reference value, in feedback ADC counts in the \ref section_pwrconv_infineon mode.
+ */
+__STATIC_FORCEINLINE uint32_t mtb_pwrconv_scale_target(mtb_stc_pwrconv_t const * inst, uint32_t targ)
+{
+    return (uint32_t)(((uint64_t)targ * (uint64_t)inst->refMul) >> inst->refShift);
 }
 
 
-/** Sets the desired target reference value \ref mtb_stc_pwrconv_ctx_t::targ for the \ref section_pwrconv_ramp.
- * In the \ref MTB_PWRCONV_STATE_RUN state, it also triggers
- * \ref MTB_PWRCONV_STATE_RAMP, see \ref  mtb_pwrconv_get_state
+/** Sets the desired target reference value \ref mtb_stc_pwrconv_cold_t::targ for the \ref section_pwrconv_ramp.
+ * The value is posted into the \ref section_pwrconv_mailbox and applied by the next \ref mtb_pwrconv_ramp call,
+ * which in the \ref MTB_PWRCONV_STATE_RUN state also triggers
+ * \ref MTB_PWRCONV_STATE_RAMP, see \ref  mtb_pwrconv_get_state.
+ * When \ref mtb_stc_pwrconv_t::ramp is zero, it is applied at once by \ref mtb_pwrconv_apply.
  *
- * \ref mtb_stc_pwrconv_ctx_t::targ is recalculated from millivolts into feedback ADC counts using the
- * \ref mtb_stc_pwrconv_t::refNum and \ref mtb_stc_pwrconv_t::refDen values in the \ref section_pwrconv_infineon mode.
+ * \ref mtb_stc_pwrconv_cold_t::targ is recalculated from millivolts into feedback ADC counts using the
+ * \ref mtb_stc_pwrconv_t::refMul and \ref mtb_stc_pwrconv_t::refShift values in the \ref section_pwrconv_infineon mode:
+ * targ * refMul >> refShift, so there is no runtime division and the result keeps the full 32-bit range.
  *
  * Also, in the \ref section_pwrconv_infineon mode, the target value is limited by
  * the \ref mtb_stc_pwrconv_t::targMax and \ref mtb_stc_pwrconv_t::targMin values -
  * they are defined by the min/max controlled parameter (Vout/Iout) in the PCC tool:
  * \image html minmax.png
  *
- * In the \ref section_pwrconv_custom mode, \ref mtb_stc_pwrconv_t::refNum and \ref mtb_stc_pwrconv_t::refDen are
- * both initialized as '1', and \ref mtb_stc_pwrconv_t::targMin and \ref mtb_stc_pwrconv_t::targMax are
+ * In the \ref section_pwrconv_custom mode, \ref mtb_stc_pwrconv_t::refMul and \ref mtb_stc_pwrconv_t::refShift are
+ * initialized as '1' and '0', and \ref mtb_stc_pwrconv_t::targMin and \ref mtb_stc_pwrconv_t::targMax are
  * the minimal and maximal uint32 values correspondingly.
  *
  * However, all these values can be customized in the application code by storing the
@@ -425,10 +1135,112 @@ __STATIC_INLINE cy_rslt_t mtb_pwrconv_set_target(mtb_stc_pwrconv_t const * inst,
     }
     else
     {
-        inst->ctx->targ = (uint16_t)(targ * (uint32_t)inst->refNum / (uint32_t)inst->refDen);
-        if (0UL != mtb_pwrconv_get_state(inst, MTB_PWRCONV_STATE_RUN))
+        mtb_pwrconv_post(inst->cold, mtb_pwrconv_scale_target(inst, targ), inst->cold->mbox.rampStep);
+        mtb_pwrconv_apply(inst);
+    }
+
+    return rslt;
+}
+
+
+/** Sets the reference ramping step, overriding the \ref mtb_stc_pwrconv_t::rampStep value
+ *  configured by the Ramp update period and Ramp slope parameters.
+ *
+ * The step is posted into the mailbox like the target by \ref mtb_pwrconv_set_target,
+ * see \ref section_pwrconv_mailbox.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ * @param[in] step The ramping step, in the reference units per \ref mtb_pwrconv_ramp call.
+ * @return         The ramping step validness status \ref group_pwrconv_status
+ *                 - \ref MTB_PWRCONV_RSLT_SUCCESS - the ramping step is valid,
+ *                 - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - the ramping step is zero.
+ */
+__STATIC_INLINE cy_rslt_t mtb_pwrconv_set_ramp_step(mtb_stc_pwrconv_t const * inst, uint32_t step)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+
+    if (0UL == step)
+    {
+        rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+    }
+    else
+    {
+        mtb_pwrconv_post(inst->cold, inst->cold->mbox.targ, step);
+        mtb_pwrconv_apply(inst);
+    }
+
+    return rslt;
+}
+
+
+/** Limits the target reference value, e.g. for the thermal derating or the current foldback.
+ *
+ * The limits are posted into the mailbox like the target by \ref mtb_pwrconv_set_target
+ * (see \ref section_pwrconv_mailbox) and applied by the next \ref mtb_pwrconv_ramp call, which moves
+ * the reference to the limited target with the ramping step. The target set by \ref mtb_pwrconv_set_target
+ * is kept, so it is restored when the limits are widened.
+ *
+ * @param[in] inst The pointer to the power converter instance structure.
+ * @param[in] min  The minimal target value, in millivolts in the \ref section_pwrconv_infineon mode.
+ * @param[in] max  The maximal target value, in millivolts in the \ref section_pwrconv_infineon mode.
+ * @return         The limits validness status \ref group_pwrconv_status
+ *                 - \ref MTB_PWRCONV_RSLT_SUCCESS - the limits are valid,
+ *                 - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - the minimum is greater than the maximum or
+ *                   the limits are outside the \ref mtb_stc_pwrconv_t::targMin and
+ *                   \ref mtb_stc_pwrconv_t::targMax range.
+ */
+__STATIC_INLINE cy_rslt_t mtb_pwrconv_set_limits(mtb_stc_pwrconv_t const * inst, uint32_t min, uint32_t max)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+
+    if ((min > max) || (inst->targMax < max) || (inst->targMin > min))
+    {
+        rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+    }
+    else
+    {
+        mtb_pwrconv_post_limits(inst->cold, mtb_pwrconv_scale_target(inst, min), mtb_pwrconv_scale_target(inst, max));
+        mtb_pwrconv_apply(inst);
+    }
+
+    return rslt;
+}
+
+
+/** Sets the desired target reference values of several power converter instances at once,
+ *  e.g. for the tracking or sequencing of the output voltages.
+ *
+ * All the targets are validated first, so either all or none of them are updated.
+ * Otherwise, it behaves like \ref mtb_pwrconv_set_target for every instance.
+ *
+ * @param[in] inst The array of pointers to the power converter instance structures.
+ * @param[in] targ The array of the target values to be set, one per instance.
+ * @param[in] num  The number of instances in the arrays.
+ * @return         The reference values validness status \ref group_pwrconv_status
+ *                 - \ref MTB_PWRCONV_RSLT_SUCCESS - all the reference values are valid,
+ *                 - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - at least one reference value is outside a valid range.
+ *
+ * \funcusage See \ref section_pwrconv_ramp section
+ */
+__STATIC_INLINE cy_rslt_t mtb_pwrconv_set_targets(mtb_stc_pwrconv_t const * const inst[],
+                                                  uint32_t const targ[], uint32_t num)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+    uint32_t idx;
+
+    for (idx = 0UL; idx < num; idx++)
+    {
+        if ((inst[idx]->targMax < targ[idx]) || (inst[idx]->targMin > targ[idx]))
         {
-            inst->ctx->state |= MTB_PWRCONV_STATE_RAMP;
+            rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+        }
+    }
+
+    if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
+    {
+        for (idx = 0UL; idx < num; idx++)
+        {
+            (void)mtb_pwrconv_set_target(inst[idx], targ[idx]);
         }
     }
 
@@ -446,24 +1258,28 @@ __STATIC_INLINE cy_rslt_t mtb_pwrconv_set_target(mtb_stc_pwrconv_t const * inst,
  */
 __STATIC_INLINE void mtb_pwrconv_ramp(mtb_stc_pwrconv_t const * inst)
 {
-    if ((0UL != mtb_pwrconv_get_state(inst, MTB_PWRCONV_STATE_RUN)) &&
-        (inst->ctx->ref != inst->ctx->targ))
+    (void)mtb_pwrconv_fetch(inst->ctx, inst->cold); /* The posted parameters are applied at the ramp step boundary */
+
+    /* The fetched state, a stop request posted meanwhile is applied by the next call */
+    if ((0UL != (inst->ctx->state & MTB_PWRCONV_STATE_RUN)) &&
+        (inst->ctx->ref != inst->cold->targ))
     {
-        int16_t locDiff = (int16_t)inst->ctx->targ - (int16_t)inst->ctx->ref;
+        /* The unsigned magnitude of the difference, so the full 32-bit reference range is supported */
+        bool     locUp   = inst->cold->targ > inst->ctx->ref;
+        uint32_t locDiff = locUp ? (inst->cold->targ - inst->ctx->ref) : (inst->ctx->ref - inst->cold->targ);
 
-        /* The absolute of locDiff is less than or equal to rampStep. */
-        if ((locDiff <= (int16_t)inst->rampStep) && (-locDiff <= (int16_t)inst->rampStep))
+        if (locDiff <= inst->cold->rampStep)
         {
-            inst->ctx->ref    = inst->ctx->targ;
+            inst->ctx->ref    = inst->cold->targ;
             inst->ctx->state &= ~MTB_PWRCONV_STATE_RAMP;
         }
-        else if (locDiff < 0)
+        else if (locUp)
         {
-            inst->ctx->ref   -= inst->rampStep;
+            inst->ctx->ref   += inst->cold->rampStep;
         }
-        else /* locDiff > 0 */
+        else
         {
-            inst->ctx->ref   += inst->rampStep;
+            inst->ctx->ref   -= inst->cold->rampStep;
         }
     }
 }
@@ -485,6 +1301,68 @@ __STATIC_FORCEINLINE int32_t mtb_pwrconv_get_error(mtb_stc_pwrconv_ctx_t * ctx)
 }
 
 
+/** Accumulates the feedback ADC result for the \ref section_pwrconv_multirate
+ *  and keeps the resolution gained by the averaging.
+ *
+ * The same as \ref mtb_pwrconv_decimate, but the average stored into \ref mtb_stc_pwrconv_ctx_t::res
+ * is scaled by 2^frac, so the reference and error should be in the same scale
+ * (see \ref mtb_stc_pwrconv_t::refFrac).
+ *
+ * \note The accumulated sum shifted by \p frac should fit into 32 bits,
+ * so 2^frac is expected to be not more than \p div for the 12-bit ADC results.
+ *
+ * @param[in] ctx    The pointer to the power converter instance context structure.
+ * @param[in] res    The feedback ADC result.
+ * @param[in] div    The decimation factor - the number of results to be averaged.
+ * @param[in] frac   The number of the fractional bits of the averaged result.
+ * @return           True when the \ref mtb_stc_pwrconv_ctx_t::res is updated
+ *                   and the regulator should be executed, false otherwise.
+ *
+ * \funcusage See \ref section_pwrconv_multirate section
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_decimate_frac(mtb_stc_pwrconv_ctx_t * ctx, uint32_t res, uint32_t div,
+                                                    uint32_t frac)
+{
+    bool rdy = false;
+
+    ctx->acc += res;
+    ctx->cnt++;
+
+    if (div <= ctx->cnt)
+    {
+        ctx->res = (ctx->acc << frac) / div; /* The boxcar average - the anti-aliasing filter */
+        ctx->acc = 0UL;
+        ctx->cnt = 0UL;
+        rdy = true;
+    }
+
+    return rdy;
+}
+
+
+/** Accumulates the feedback ADC result for the \ref section_pwrconv_multirate.
+ *
+ * Every call adds the result into \ref mtb_stc_pwrconv_ctx_t::acc. When \p div
+ * results are accumulated, their average is stored into \ref mtb_stc_pwrconv_ctx_t::res
+ * and the accumulator is restarted.
+ *
+ * \note The \p div is expected to be a compile-time constant
+ * (like the generated myPwrConv_FAST_DIV), so the averaging division is optimized by the compiler.
+ *
+ * @param[in] ctx    The pointer to the power converter instance context structure.
+ * @param[in] res    The feedback ADC result.
+ * @param[in] div    The decimation factor - the number of results to be averaged.
+ * @return           True when the \ref mtb_stc_pwrconv_ctx_t::res is updated
+ *                   and the regulator should be executed, false otherwise.
+ *
+ * \funcusage See \ref section_pwrconv_multirate section
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_decimate(mtb_stc_pwrconv_ctx_t * ctx, uint32_t res, uint32_t div)
+{
+    return mtb_pwrconv_decimate_frac(ctx, res, div, 0UL);
+}
+
+
 /** \} group_pwrconv_functions */
 
 #ifdef __cplusplus
@@ -0,0 +1,203 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_burst.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion light-load burst mode.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_burst Light-load burst mode
+ */
+
+#ifndef MTB_PWRCONV_BURST_H
+#define MTB_PWRCONV_BURST_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_burst
+ * \{
+ */
+
+/** The burst mode configuration structure */
+typedef struct
+{
+    uint32_t enter;    /* The modulator value below which the burst mode is entered */
+    uint32_t delay;    /* The number of the consecutive control loop periods below the entry threshold */
+    uint32_t mod;      /* The modulator value during the burst */
+    int32_t  low;      /* The error above which the burst starts (the feedback is below the reference), counts */
+    int32_t  high;     /* The error below which the burst stops (the feedback is above the reference), counts */
+    int32_t  exit;     /* The error above which the regulator takes the control back, counts */
+    uint32_t maxLen;   /* The maximal burst length, control loop periods, the regulator takes the control back
+                        * when the burst can't reach the upper threshold */
+    void (*gate)(bool on); /* The PWM outputs gating function, called on the burst start and stop only */
+} mtb_stc_pwrconv_burst_cfg_t;
+
+/** The burst mode internal data structure */
+typedef struct
+{
+    bool     active;   /* The burst mode controls the modulator */
+    bool     on;       /* The PWM outputs are not gated */
+    uint32_t cnt;      /* The entry delay or the burst length counter, control loop periods */
+    uint32_t bursts;   /* The number of the bursts since the initialization */
+} mtb_stc_pwrconv_burst_dat_t;
+
+/** The burst mode working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_burst_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_burst_dat_t dat; /* The burst mode internal data */
+} mtb_stc_pwrconv_burst_ctx_t;
+
+/** Initialize the burst mode
+ *
+ * The burst mode is inactive and the PWM outputs are not gated after the initialization.
+ * Should be called when the control loop is not running - typically, by the myPwrConv_init_reg().
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @return               The initialization status.
+ */
+cy_rslt_t mtb_pwrconv_burst_init(mtb_stc_pwrconv_burst_ctx_t * ctx, mtb_stc_pwrconv_burst_cfg_t const * cfg);
+
+/** Returns the burst mode activity
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               True when the burst mode controls the modulator.
+ */
+__STATIC_INLINE bool mtb_pwrconv_burst_is_active(mtb_stc_pwrconv_burst_ctx_t const * ctx)
+{
+    return ctx->dat.active;
+}
+
+/** Run the burst mode hysteretic control
+ *
+ * In the continuous regulation, counts the control loop periods with the modulator value below
+ * the entry threshold, the ramp resets the count.
+ * In the burst mode, gates the PWM outputs when the feedback exceeds the upper threshold and ungates them
+ * with the fixed burst modulator value when the feedback falls below the lower threshold,
+ * so the converter switches only during the bursts.
+ * When the feedback falls below the exit threshold or the burst is too long (the load is increased),
+ * the burst mode is left and the regulator continues from its history frozen at the entry:
+ * the function returns false, so the regulator is executed in the same control loop period.
+ *
+ * Should be called every control loop period instead of the regulator,
+ * the regulator should be executed only when this function returns false.
+ *
+ * @param[in,out] ctx    The pointer to the data structure, which holds the computation context.
+ * @param[in,out] pwr    The pointer to the power converter instance context structure:
+ *                       \ref mtb_stc_pwrconv_ctx_t::err and \ref mtb_stc_pwrconv_ctx_t::state are used,
+ *                       \ref mtb_stc_pwrconv_ctx_t::mod is used and updated in the burst mode.
+ * @return               True when the burst mode controls the modulator, false for the continuous regulation.
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_burst_process(mtb_stc_pwrconv_burst_ctx_t * ctx, mtb_stc_pwrconv_ctx_t * pwr)
+{
+    int32_t err = pwr->err;
+
+    if (!ctx->dat.active)
+    {
+        if ((pwr->mod < ctx->cfg.enter) && (0UL == (pwr->state & MTB_PWRCONV_STATE_RAMP)))
+        {
+            ctx->dat.cnt++;
+            if (ctx->dat.cnt >= ctx->cfg.delay)
+            {
+                /* The light load: the regulator history is frozen from now on */
+                ctx->dat.active = true;
+                ctx->dat.on     = false;
+                ctx->dat.cnt    = 0UL;
+                ctx->cfg.gate(false);
+            }
+        }
+        else
+        {
+            ctx->dat.cnt = 0UL;
+        }
+    }
+    else if ((err > ctx->cfg.exit) || (ctx->dat.cnt >= ctx->cfg.maxLen))
+    {
+        /* The load is increased: the regulator takes the control back in this period */
+        ctx->dat.active = false;
+        ctx->dat.cnt    = 0UL;
+        if (!ctx->dat.on)
+        {
+            ctx->dat.on = true;
+            ctx->cfg.gate(true);
+        }
+    }
+    else if (ctx->dat.on)
+    {
+        if (err < ctx->cfg.high)
+        {
+            ctx->dat.on = false;
+            ctx->cfg.gate(false);
+        }
+        else
+        {
+            ctx->dat.cnt++;
+        }
+    }
+    else if (err > ctx->cfg.low)
+    {
+        ctx->dat.on  = true;
+        ctx->dat.cnt = 0UL;
+        ctx->dat.bursts++;
+        ctx->cfg.gate(true);
+    }
+    else
+    {
+        /* The pulses are skipped */
+    }
+
+    if (ctx->dat.active)
+    {
+        pwr->mod = ctx->cfg.mod;
+    }
+
+    return ctx->dat.active;
+}
+
+
+/** \} group_pwrconv_burst */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_BURST_H */
+
+/* [] END OF FILE */
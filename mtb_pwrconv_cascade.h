@@ -0,0 +1,172 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_cascade.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion cascaded (multi-loop) control.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_cascade Cascaded control loops
+ */
+
+#ifndef MTB_PWRCONV_CASCADE_H
+#define MTB_PWRCONV_CASCADE_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_cascade
+ * \{
+ */
+
+/** The maximal outer loop decimation factor, the averaged sum of the 12-bit ADC results should be below 2^30 */
+#define MTB_PWRCONV_CASCADE_DIV_MAX     (0x40000UL)
+
+/** The cascaded control loops context structure
+ *
+ * The outer (slow) loop output \ref mtb_stc_pwrconv_ctx_t::mod is the source of the inner (fast) loop reference,
+ * each loop has its own regulator context, see \ref section_pwrconv_cascade.
+ * Initialized by \ref mtb_pwrconv_cascade_init.
+ */
+typedef struct
+{
+    mtb_stc_pwrconv_ctx_t outer; /**< The outer loop context, e.g. the DC-bus voltage */
+    mtb_stc_pwrconv_ctx_t inner; /**< The inner loop context, e.g. the average inductor current */
+    uint32_t                div; /**< The outer loop decimation factor - the number of inner loop periods per
+                                  *   outer loop period, the outer feedback is averaged over them
+                                  */
+    uint32_t                mul; /**< The averaging reciprocal 2^shift / div, rounded up */
+    uint32_t              shift; /**< The averaging reciprocal shift, 31 + floor(log2(div)) */
+} mtb_stc_pwrconv_cascade_t;
+
+/** Initializes the cascaded loops decimation
+ *
+ * Pre-calculates the reciprocal of the decimation factor, so the outer feedback averaging
+ * in \ref mtb_pwrconv_cascade_outer is the multiplication and shift instead of the division,
+ * which is exact for the accumulated sum below 2^30. Restarts the outer feedback accumulation.
+ *
+ * @param[in,out] casc   The pointer to the cascaded loops context.
+ * @param[in] div        The outer loop decimation factor, 1..\ref MTB_PWRCONV_CASCADE_DIV_MAX.
+ * @return               The initialization status
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the decimation factor is valid,
+ *                       - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - the decimation factor is out of range.
+ */
+__STATIC_INLINE cy_rslt_t mtb_pwrconv_cascade_init(mtb_stc_pwrconv_cascade_t * casc, uint32_t div)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+
+    if ((0UL < div) && (MTB_PWRCONV_CASCADE_DIV_MAX >= div))
+    {
+        uint32_t lg = 0UL;
+
+        while ((2UL << lg) <= div)
+        {
+            lg++; /* floor(log2(div)) */
+        }
+
+        /* The mul is in the (2^30, 2^31] range, so the rounding error of the average is below 1 / div */
+        casc->div   = div;
+        casc->shift = 31UL + lg;
+        casc->mul   = (uint32_t)(((1ULL << casc->shift) + (uint64_t)div - 1ULL) / (uint64_t)div);
+        casc->outer.acc = 0UL;
+        casc->outer.cnt = 0UL;
+        rslt = MTB_PWRCONV_RSLT_SUCCESS;
+    }
+
+    return rslt;
+}
+
+/** Accumulates the outer loop feedback and calculates the outer loop error when its period ends.
+ *
+ * Should be called every inner loop period. The feedback is averaged the same way as
+ * by \ref mtb_pwrconv_decimate, so the inner loop switching ripple (and e.g. the double line frequency ripple
+ * for the suitable decimation) is not aliased into the outer loop. The average is calculated
+ * by the reciprocal pre-calculated by \ref mtb_pwrconv_cascade_init, so there is no division in the ISR
+ * for any decimation factor.
+ *
+ * @param[in,out] casc   The pointer to the cascaded loops context.
+ * @param[in] res        The outer loop feedback ADC result.
+ * @return               True when the outer loop error \ref mtb_stc_pwrconv_ctx_t::err is updated
+ *                       and the outer regulator should be executed, false otherwise.
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_cascade_outer(mtb_stc_pwrconv_cascade_t * casc, uint32_t res)
+{
+    bool rdy = false;
+
+    casc->outer.acc += res;
+    casc->outer.cnt++;
+
+    if (casc->div <= casc->outer.cnt)
+    {
+        /* The boxcar average acc / div by the reciprocal */
+        casc->outer.res = (uint32_t)(((uint64_t)casc->outer.acc * casc->mul) >> casc->shift);
+        casc->outer.acc = 0UL;
+        casc->outer.cnt = 0UL;
+        (void)mtb_pwrconv_get_error(&casc->outer);
+        rdy = true;
+    }
+
+    return rdy;
+}
+
+/** Sets the inner loop reference and feedback and calculates the inner loop error.
+ *
+ * @param[in,out] casc   The pointer to the cascaded loops context.
+ * @param[in] ref        The inner loop reference - the outer loop output \ref mtb_stc_pwrconv_ctx_t::mod,
+ *                       directly or shaped, e.g. by \ref mtb_pwrconv_pfc_float_ref.
+ * @param[in] res        The inner loop feedback ADC result.
+ * @return               The inner loop error, also saved into \ref mtb_stc_pwrconv_ctx_t::err.
+ */
+__STATIC_FORCEINLINE int32_t mtb_pwrconv_cascade_inner(mtb_stc_pwrconv_cascade_t * casc, uint32_t ref, uint32_t res)
+{
+    casc->inner.ref = ref;
+    casc->inner.res = res;
+
+    return mtb_pwrconv_get_error(&casc->inner);
+}
+
+
+/** \} group_pwrconv_cascade */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_CASCADE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,194 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_obs_float.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion floating point state observer.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_obs_float Floating point load current observer
+ */
+
+#ifndef MTB_PWRCONV_OBS_FLOAT_H
+#define MTB_PWRCONV_OBS_FLOAT_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_obs_float
+ * \{
+ */
+
+/** The observer state vector index of the inductor current estimation, A */
+#define MTB_PWRCONV_OBS_IL      (0U)
+/** The observer state vector index of the output voltage estimation, V */
+#define MTB_PWRCONV_OBS_VOUT    (1U)
+/** The observer state vector index of the load current estimation, A */
+#define MTB_PWRCONV_OBS_ILOAD   (2U)
+
+/** The observer configuration structure */
+typedef struct
+{
+    float32_t a[3][3]; /* The discrete plant state transition matrix */
+    float32_t b[3];    /* The discrete plant input vector, per modulator count */
+    float32_t l[3];    /* The observer (current estimator) gains */
+    float32_t k;       /* The feedback scaling: volts per ADC count */
+    float32_t off;     /* The modulator offset, counts */
+    float32_t ff;      /* The feedforward gain: modulator counts per ampere, zero to disable */
+    float32_t min;     /* Lower modulator limit after the feedforward */
+    float32_t max;     /* Upper modulator limit after the feedforward */
+} mtb_stc_pwrconv_obs_float_cfg_t;
+
+/** The observer internal data structure */
+typedef struct
+{
+    float32_t x[3]; /* The estimated state: inductor current, output voltage, load current */
+} mtb_stc_pwrconv_obs_float_dat_t;
+
+/** The observer working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_obs_float_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_obs_float_dat_t dat; /* The observer internal data */
+} mtb_stc_pwrconv_obs_float_ctx_t;
+
+/** Initialize the Observer
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @return               The initialization status.
+ */
+cy_rslt_t mtb_pwrconv_obs_float_init(mtb_stc_pwrconv_obs_float_ctx_t * ctx,
+                                     mtb_stc_pwrconv_obs_float_cfg_t const * cfg);
+
+/** Run the Observer
+ *
+ * Predicts the state from the previous estimation and the modulator value applied during the last period,
+ * then corrects the prediction by the output voltage measurement error.
+ * The constant execution time is 16 multiplications (12 for the prediction, 4 for the correction).
+ * Should be called once per control loop period, before the regulator.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] res        The feedback ADC result - typically, \ref mtb_stc_pwrconv_ctx_t::res.
+ * @param[in] mod        The last applied modulator value - typically, \ref mtb_stc_pwrconv_ctx_t::mod.
+ * @return               The processing status.
+ */
+__STATIC_FORCEINLINE cy_rslt_t mtb_pwrconv_obs_float_process(mtb_stc_pwrconv_obs_float_ctx_t * ctx,
+                                                             uint32_t res, uint32_t mod)
+{
+    float32_t u = (float32_t)mod - ctx->cfg.off;
+    float32_t p0; /* Predicted state */
+    float32_t p1;
+    float32_t p2;
+    float32_t e;  /* Measurement error */
+
+    /* Prediction */
+    p0  = ctx->cfg.a[0][0] * ctx->dat.x[0];
+    p0 += ctx->cfg.a[0][1] * ctx->dat.x[1];
+    p0 += ctx->cfg.a[0][2] * ctx->dat.x[2];
+    p0 += ctx->cfg.b[0] * u;
+    p1  = ctx->cfg.a[1][0] * ctx->dat.x[0];
+    p1 += ctx->cfg.a[1][1] * ctx->dat.x[1];
+    p1 += ctx->cfg.a[1][2] * ctx->dat.x[2];
+    p1 += ctx->cfg.b[1] * u;
+    p2  = ctx->cfg.a[2][0] * ctx->dat.x[0];
+    p2 += ctx->cfg.a[2][1] * ctx->dat.x[1];
+    p2 += ctx->cfg.a[2][2] * ctx->dat.x[2];
+    p2 += ctx->cfg.b[2] * u;
+
+    /* Correction */
+    e = (ctx->cfg.k * (float32_t)res) - p1;
+    ctx->dat.x[0] = p0 + (ctx->cfg.l[0] * e);
+    ctx->dat.x[1] = p1 + (ctx->cfg.l[1] * e);
+    ctx->dat.x[2] = p2 + (ctx->cfg.l[2] * e);
+
+    return MTB_PWRCONV_RSLT_SUCCESS; /* For future capability */
+}
+
+/** Apply the load current feedforward to the modulator value
+ *
+ * Adds the estimated difference between the load and inductor currents,
+ * scaled by \ref mtb_stc_pwrconv_obs_float_cfg_t::ff, to the regulator output.
+ * In the steady state the difference is zero, so the feedforward only acts
+ * during the load transients and does not interfere with the regulator integrator.
+ * Should be called after the regulator.
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[in,out] mod    The pointer to the modulator value - typically, \ref mtb_stc_pwrconv_ctx_t::mod.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_obs_float_feedforward(mtb_stc_pwrconv_obs_float_ctx_t const * ctx, uint32_t * mod)
+{
+    float32_t d = ctx->dat.x[MTB_PWRCONV_OBS_ILOAD] - ctx->dat.x[MTB_PWRCONV_OBS_IL]; /* The current difference */
+    float32_t m = (float32_t)*mod + (ctx->cfg.ff * d);
+
+    m = (m < ctx->cfg.max) ? m : ctx->cfg.max;
+    m = (m > ctx->cfg.min) ? m : ctx->cfg.min;
+
+    *mod = (uint32_t)m;
+}
+
+/** Returns the estimated load current
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               The estimated load current, A.
+ */
+__STATIC_FORCEINLINE float32_t mtb_pwrconv_obs_float_get_load(mtb_stc_pwrconv_obs_float_ctx_t const * ctx)
+{
+    return ctx->dat.x[MTB_PWRCONV_OBS_ILOAD];
+}
+
+/** Returns the estimated inductor current
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               The estimated inductor current (sum of all phases), A.
+ */
+__STATIC_FORCEINLINE float32_t mtb_pwrconv_obs_float_get_current(mtb_stc_pwrconv_obs_float_ctx_t const * ctx)
+{
+    return ctx->dat.x[MTB_PWRCONV_OBS_IL];
+}
+
+
+/** \} group_pwrconv_obs_float */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_OBS_FLOAT_H */
+
+/* [] END OF FILE */
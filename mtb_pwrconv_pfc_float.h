@@ -0,0 +1,206 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_pfc_float.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion floating point PFC line synchronization.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_pfc_float Floating point PFC line synchronization
+ */
+
+#ifndef MTB_PWRCONV_PFC_FLOAT_H
+#define MTB_PWRCONV_PFC_FLOAT_H
+
+#include "mtb_pwrconv.h"
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_pfc_float
+ * \{
+ */
+
+/** The PFC line synchronization configuration structure */
+typedef struct
+{
+    float32_t k;      /* The reference scaling: the nominal input voltage mean square divided by its peak,
+                       * counts, so the reference peak equals the amplitude at the nominal line voltage */
+    uint32_t  zcLow;  /* The rectified input voltage zero crossing threshold, counts */
+    uint32_t  zcHigh; /* The rectified input voltage re-arming threshold, counts */
+    float32_t msMin;  /* The minimal valid input voltage mean square (brown-out), counts^2 */
+    uint32_t  nMin;   /* The minimal valid half-cycle length (maximal line frequency), samples */
+    uint32_t  nMax;   /* The maximal valid half-cycle length (minimal line frequency), samples */
+    uint32_t  max;    /* The inner loop reference limit, counts */
+} mtb_stc_pwrconv_pfc_float_cfg_t;
+
+/** The PFC line synchronization internal data structure */
+typedef struct
+{
+    float32_t sum;  /* The input voltage square accumulator */
+    uint32_t  n;    /* The number of the accumulated samples */
+    bool      arm;  /* The input voltage is above the re-arming threshold */
+    bool      ok;   /* The last half-cycle is valid */
+    float32_t ms;   /* The input voltage mean square of the last valid half-cycle */
+    float32_t inv;  /* The feedforward factor k / ms */
+    uint32_t  cnt;  /* The number of the detected half-cycles */
+} mtb_stc_pwrconv_pfc_float_dat_t;
+
+/** The PFC line synchronization working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_pfc_float_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_pfc_float_dat_t dat; /* The internal data */
+} mtb_stc_pwrconv_pfc_float_ctx_t;
+
+/** Initialize the PFC line synchronization
+ *
+ * The feedforward starts from the nominal line voltage and the line is reported invalid
+ * until the first valid half-cycle is measured.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @return               The initialization status
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the configuration is valid,
+ *                       - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - a NULL pointer,
+ *                         the thresholds or limits are inconsistent.
+ */
+cy_rslt_t mtb_pwrconv_pfc_float_init(mtb_stc_pwrconv_pfc_float_ctx_t * ctx,
+                                     mtb_stc_pwrconv_pfc_float_cfg_t const * cfg);
+
+/** Track the line
+ *
+ * Accumulates the rectified input voltage square and detects the half-cycle boundaries by its zero crossing.
+ * At every boundary the mean square (RMS squared) of the half-cycle is latched and its reciprocal
+ * is calculated, so the division is executed once per half-cycle only.
+ * Should be called every inner loop period.
+ *
+ * @param[in,out] ctx    The pointer to the data structure, which holds the computation context.
+ * @param[in] vin        The rectified input voltage ADC result.
+ * @return               True at the half-cycle boundary.
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_pfc_float_line(mtb_stc_pwrconv_pfc_float_ctx_t * ctx, uint32_t vin)
+{
+    bool zc = false;
+    float32_t v = (float32_t)vin;
+
+    ctx->dat.sum += v * v;
+    ctx->dat.n++;
+
+    if (vin > ctx->cfg.zcHigh)
+    {
+        ctx->dat.arm = true;
+    }
+    else if (ctx->dat.arm && (vin < ctx->cfg.zcLow))
+    {
+        float32_t ms = ctx->dat.sum / (float32_t)ctx->dat.n;
+
+        ctx->dat.ok = (ctx->dat.n >= ctx->cfg.nMin) && (ctx->dat.n <= ctx->cfg.nMax) && (ms >= ctx->cfg.msMin);
+        if (ctx->dat.ok)
+        {
+            ctx->dat.ms  = ms;
+            ctx->dat.inv = ctx->cfg.k / ms;
+        }
+        ctx->dat.sum = 0.0f;
+        ctx->dat.n   = 0UL;
+        ctx->dat.arm = false;
+        ctx->dat.cnt++;
+        zc = true;
+    }
+    else if (ctx->dat.n > ctx->cfg.nMax)
+    {
+        ctx->dat.ok  = false; /* No zero crossing: DC input or line loss */
+        ctx->dat.sum = 0.0f;
+        ctx->dat.n   = 0UL;
+    }
+    else
+    {
+        /* Within the half-cycle */
+    }
+
+    return zc;
+}
+
+/** Calculates the rectified-sine inner (current) loop reference with the input voltage RMS feedforward
+ *
+ * ref = amp * vin * k / ms, so the input current follows the input voltage shape,
+ * and for the constant amplitude (the outer loop output) the input power does not depend on the line voltage.
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[in] amp        The reference amplitude - typically, the outer loop output \ref mtb_stc_pwrconv_ctx_t::mod.
+ * @param[in] vin        The rectified input voltage ADC result.
+ * @return               The inner loop reference, counts.
+ */
+__STATIC_FORCEINLINE uint32_t mtb_pwrconv_pfc_float_ref(mtb_stc_pwrconv_pfc_float_ctx_t const * ctx,
+                                                        uint32_t amp, uint32_t vin)
+{
+    float32_t ref = (float32_t)amp * (float32_t)vin * ctx->dat.inv;
+    float32_t max = (float32_t)ctx->cfg.max;
+
+    return (uint32_t)((ref < max) ? ref : max);
+}
+
+/** Returns the line validity
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               True when the last half-cycle length and RMS are valid.
+ */
+__STATIC_INLINE bool mtb_pwrconv_pfc_float_line_ok(mtb_stc_pwrconv_pfc_float_ctx_t const * ctx)
+{
+    return ctx->dat.ok;
+}
+
+/** Returns the input voltage RMS of the last valid half-cycle
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               The input voltage RMS, counts.
+ */
+__STATIC_INLINE float32_t mtb_pwrconv_pfc_float_get_rms(mtb_stc_pwrconv_pfc_float_ctx_t const * ctx)
+{
+    return sqrtf(ctx->dat.ms);
+}
+
+
+/** \} group_pwrconv_pfc_float */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_PFC_FLOAT_H */
+
+/* [] END OF FILE */
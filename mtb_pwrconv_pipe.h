@@ -0,0 +1,181 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_pipe.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion custom control loop pipeline stages.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_pipe Custom control loop pipeline
+ */
+
+#ifndef MTB_PWRCONV_PIPE_H
+#define MTB_PWRCONV_PIPE_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_pipe
+ * \{
+ */
+
+/** The input conditioning stage structure - the first order low-pass filter of the feedback */
+typedef struct
+{
+    uint32_t shift; /**< The filter time constant as log2 of the sampling periods, 0 to bypass */
+    uint32_t   acc; /**< The filter accumulator, the filtered value scaled by 2^shift */
+} mtb_stc_pwrconv_pipe_filt_t;
+
+/** The feedforward stage structure */
+typedef struct
+{
+    float32_t          gain; /**< The modulator counts per feedforward input unit */
+    float32_t           off; /**< The feedforward input value, which does not change the modulator */
+    volatile float32_t   in; /**< The feedforward input, updated by the application from any context,
+                              *   e.g. the input voltage measured by the \ref section_pwrconv_scheduled
+                              */
+} mtb_stc_pwrconv_pipe_ff_t;
+
+/** The limiter stage structure */
+typedef struct
+{
+    uint32_t  min; /**< The minimal output value */
+    uint32_t  max; /**< The maximal output value */
+    uint32_t slew; /**< The maximal output change per control loop period, max - min to disable */
+    uint32_t prev; /**< The previous output value */
+} mtb_stc_pwrconv_pipe_limit_t;
+
+/** The modulator mapping stage structure - the regulator output into the modulator counts */
+typedef struct
+{
+    uint32_t   mul; /**< The fixed-point multiplier, the modulator counts per regulator output unit
+                     *   scaled by 2^shift
+                     */
+    uint8_t  shift; /**< The right shift of the product, up to 32 */
+    uint32_t   off; /**< The modulator value at the zero regulator output */
+} mtb_stc_pwrconv_pipe_map_t;
+
+
+/** Resets the input conditioning stage to the specified feedback value, e.g. before the start.
+ *
+ * @param[in,out] filt   The pointer to the input conditioning stage.
+ * @param[in] in         The initial feedback value.
+ */
+__STATIC_INLINE void mtb_pwrconv_pipe_filt_reset(mtb_stc_pwrconv_pipe_filt_t * filt, uint32_t in)
+{
+    filt->acc = in << filt->shift;
+}
+
+/** The input conditioning stage: filters the feedback into \ref mtb_stc_pwrconv_ctx_t::res.
+ *
+ * @param[in,out] filt   The pointer to the input conditioning stage.
+ * @param[in,out] ctx    The pointer to the power converter instance context structure.
+ * @param[in] in         The feedback ADC result.
+ * @return               The filtered feedback value, also saved into \ref mtb_stc_pwrconv_ctx_t::res.
+ */
+__STATIC_FORCEINLINE uint32_t mtb_pwrconv_pipe_filt(mtb_stc_pwrconv_pipe_filt_t * filt,
+                                                    mtb_stc_pwrconv_ctx_t * ctx, uint32_t in)
+{
+    filt->acc += in - (filt->acc >> filt->shift);
+    ctx->res   = filt->acc >> filt->shift;
+
+    return ctx->res;
+}
+
+/** The feedforward stage: adds the scaled feedforward input to the regulator output
+ *  \ref mtb_stc_pwrconv_ctx_t::mod. Should be followed by the limiter stage.
+ *
+ * @param[in] ff         The pointer to the feedforward stage.
+ * @param[in,out] ctx    The pointer to the power converter instance context structure.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_pipe_ff(mtb_stc_pwrconv_pipe_ff_t const * ff, mtb_stc_pwrconv_ctx_t * ctx)
+{
+    float32_t m = (float32_t)ctx->mod + (ff->gain * (ff->in - ff->off));
+
+    ctx->mod = (m > 0.0f) ? (uint32_t)m : 0UL;
+}
+
+/** Resets the limiter stage slew rate history to the specified output value, e.g. before the start.
+ *
+ * @param[in,out] lim    The pointer to the limiter stage.
+ * @param[in] out        The initial output value, between the limiter minimum and maximum.
+ */
+__STATIC_INLINE void mtb_pwrconv_pipe_limit_reset(mtb_stc_pwrconv_pipe_limit_t * lim, uint32_t out)
+{
+    lim->prev = out;
+}
+
+/** The limiter stage: limits the \ref mtb_stc_pwrconv_ctx_t::mod value and its change per period.
+ *
+ * @param[in,out] lim    The pointer to the limiter stage.
+ * @param[in,out] ctx    The pointer to the power converter instance context structure.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_pipe_limit(mtb_stc_pwrconv_pipe_limit_t * lim, mtb_stc_pwrconv_ctx_t * ctx)
+{
+    uint32_t hi = ((lim->max - lim->prev) > lim->slew) ? (lim->prev + lim->slew) : lim->max;
+    uint32_t lo = ((lim->prev - lim->min) > lim->slew) ? (lim->prev - lim->slew) : lim->min;
+    uint32_t m  = ctx->mod;
+
+    m = (m < hi) ? m : hi;
+    m = (m > lo) ? m : lo;
+
+    lim->prev = m;
+    ctx->mod  = m;
+}
+
+/** The modulator mapping stage: recalculates the \ref mtb_stc_pwrconv_ctx_t::mod value
+ *  from the regulator output units into the modulator counts: mod * mul >> shift + off.
+ *
+ * @param[in] map        The pointer to the modulator mapping stage.
+ * @param[in,out] ctx    The pointer to the power converter instance context structure.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_pipe_map(mtb_stc_pwrconv_pipe_map_t const * map, mtb_stc_pwrconv_ctx_t * ctx)
+{
+    ctx->mod = (uint32_t)(((uint64_t)ctx->mod * (uint64_t)map->mul) >> map->shift) + map->off;
+}
+
+
+/** \} group_pwrconv_pipe */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_PIPE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,163 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_pred_float.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion floating point predictive (deadbeat) regulator.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_pred_float Floating point predictive (deadbeat) regulator
+ */
+
+#ifndef MTB_PWRCONV_PRED_FLOAT_H
+#define MTB_PWRCONV_PRED_FLOAT_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_pred_float
+ * \{
+ */
+
+/** The regulator configuration structure */
+typedef struct
+{
+    float32_t k;       /* The output capacitor charge gain C / (Ts * Ki): the inductor current change per sampling
+                        * period, which changes the feedback by one count, in modulator counts */
+    float32_t gain;    /* The deadbeat correction gain, 1 for the two periods settling */
+    float32_t filt;    /* The load current estimation filter coefficient, 1 for the unfiltered estimation */
+    float32_t ripple;  /* The half inductor current ripple at the nominal duty cycle, modulator counts */
+    float32_t ramp;    /* The compensation ramp drop during the nominal on-time, modulator counts */
+    float32_t stopMin; /* The slope stop value limit - the SLOPE_STOP_MIN */
+    float32_t min;     /* Lower output limit - the SLOPE_START_MIN */
+    float32_t max;     /* Upper output limit - the SLOPE_START_MAX */
+} mtb_stc_pwrconv_reg_pred_float_cfg_t;
+
+/** The regulator internal data structure */
+typedef struct
+{
+    float32_t res;     /* The previous feedback, negative until the first feedback is processed */
+    float32_t u[2];    /* The applied average inductor current commands of the previous two periods */
+    float32_t load;    /* The estimated load current, modulator counts */
+} mtb_stc_pwrconv_reg_pred_float_dat_t;
+
+/** The regulator working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_reg_pred_float_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_reg_pred_float_dat_t dat; /* The regulator internal data */
+} mtb_stc_pwrconv_reg_pred_float_ctx_t;
+
+/** Initialize the predictive regulator
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @return               The initialization status.
+ */
+cy_rslt_t mtb_pwrconv_pred_float_init(mtb_stc_pwrconv_reg_pred_float_ctx_t * ctx,
+                                      mtb_stc_pwrconv_reg_pred_float_cfg_t const * cfg);
+
+/** Run the predictive regulator
+ *
+ * The peak current mode outer regulator: the output capacitor voltage is predicted one period ahead
+ * by the already applied command, then the average inductor current command is calculated to reach
+ * the reference at the end of the next period (the modulator value is applied with one period delay).
+ * The load current is estimated by the feedback change (not the error change, so the reference ramp
+ * or step is not taken for a load step) and the command applied two periods ago,
+ * so the model inaccuracy is compensated and there is no steady-state error.
+ * The first call after the initialization takes its feedback as the previous one, so the load estimation
+ * starts from zero instead of the step from the zero feedback.
+ *
+ * The average current command is converted into the DAC slope start value by adding the compensation
+ * ramp drop and the half inductor ripple. When the slope is stopped by the SLOPE_STOP_MIN limit
+ * (like the generated control loop ISR does), the ramp drop is reduced and the applied current is
+ * recalculated, also the limited output is used for the prediction, so there is no windup.
+ *
+ * @param[in,out] ctx    The pointer to the data structure, which holds the computation context.
+ * @param[in] input      The error value - typically, \ref mtb_stc_pwrconv_ctx_t::err.
+ * @param[in] res        The feedback value the error is calculated from - typically, \ref mtb_stc_pwrconv_ctx_t::res.
+ * @param[out] output    The pointer to the output data - typically, the pointer to the modulator value.
+ * @return               The processing status.
+ */
+__STATIC_FORCEINLINE cy_rslt_t mtb_pwrconv_pred_float_process(mtb_stc_pwrconv_reg_pred_float_ctx_t * ctx,
+                                                              int32_t input, uint32_t res, uint32_t * output)
+{
+    float32_t e = (float32_t)input;
+    float32_t f = (float32_t)res;
+    float32_t l;  /* The load current estimation */
+    float32_t u;  /* The average inductor current command */
+    float32_t o;  /* The output */
+    float32_t d;  /* The ramp drop */
+
+    /* The feedback change during the last period is caused by the command applied two periods ago,
+     * there is no change before the first feedback
+     */
+    ctx->dat.res = (0.0f > ctx->dat.res) ? f : ctx->dat.res;
+    l = ctx->dat.u[1] + (ctx->cfg.k * (ctx->dat.res - f));
+    l = ctx->dat.load + (ctx->cfg.filt * (l - ctx->dat.load));
+    ctx->dat.load = l;
+    ctx->dat.res = f;
+
+    /* The error predicted at the end of the current period is corrected during the next one */
+    u = l + (ctx->cfg.gain * ((ctx->cfg.k * e) - (ctx->dat.u[0] - l)));
+
+    /* The DAC slope start value and its limitations */
+    o = u + ctx->cfg.ripple + ctx->cfg.ramp;
+    o = (o < ctx->cfg.max) ? o : ctx->cfg.max;
+    o = (o > ctx->cfg.min) ? o : ctx->cfg.min;
+    d = o - ctx->cfg.stopMin;
+    d = (d < ctx->cfg.ramp) ? d : ctx->cfg.ramp;
+    d = (d > 0.0f) ? d : 0.0f;
+
+    ctx->dat.u[1] = ctx->dat.u[0];
+    ctx->dat.u[0] = o - d - ctx->cfg.ripple;
+    *output = (uint32_t)o;
+
+    return MTB_PWRCONV_RSLT_SUCCESS; /* For future capability */
+}
+
+
+/** \} group_pwrconv_pred_float */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_PRED_FLOAT_H */
+
+/* [] END OF FILE */
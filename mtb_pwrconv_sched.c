@@ -0,0 +1,350 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_sched.c
+* \version 1.0
+* \brief Provides API implementation for the Power Conversion control loop ISR scheduler.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "mtb_pwrconv_sched.h"
+
+/* The number of the periodic ISR jobs per instance: the light (accumulating) and heavy (regulator) ISRs */
+#define MTB_PWRCONV_SCHED_JOBS  (2UL)
+
+/* The periodic ISR job */
+typedef struct
+{
+    uint32_t period;                         /* The job period */
+    uint32_t  start;                         /* The first job start time */
+    uint32_t    len;                         /* The job execution time */
+} mtb_stc_pwrconv_sched_job_t;
+
+/* The search state */
+typedef struct
+{
+    mtb_stc_pwrconv_sched_t const * sched;
+    uint32_t num;
+    uint32_t gap;                            /* The required idle gap after every ISR */
+    uint32_t placed;                         /* The mask of the instances with the assigned shifts */
+    uint32_t ofs[MTB_PWRCONV_SCHED_MAX];     /* The PWM period start time shifts */
+} mtb_stc_pwrconv_sched_srch_t;
+
+
+static uint32_t mtb_pwrconv_sched_gcd(uint32_t a, uint32_t b)
+{
+    uint32_t locA = a;
+    uint32_t locB = b;
+
+    while (0UL != locB)
+    {
+        uint32_t locR = locA % locB;
+        locA = locB;
+        locB = locR;
+    }
+
+    return locA;
+}
+
+
+/* Gets the ISR job of the task, which PWM period starts at ofs. Returns false when the task has no such job.
+ * The first ISR starts delay after the PWM period start, the heavy one of the decimated task is the div-th ISR.
+ */
+static bool mtb_pwrconv_sched_job(mtb_stc_pwrconv_sched_t const * task, uint32_t job, uint32_t ofs,
+                                  mtb_stc_pwrconv_sched_job_t * dst)
+{
+    bool dec = (1UL < task->div);
+    bool has = (job < (dec ? MTB_PWRCONV_SCHED_JOBS : 1UL));
+
+    if (has)
+    {
+        dst->period = task->period;
+        dst->start  = (ofs + task->delay) % task->period;
+        dst->len    = dec ? task->light : task->wcet;
+
+        if (0UL != job)
+        {
+            dst->start += (task->div - 1UL) * task->period;
+            dst->period *= task->div;
+            dst->len     = task->wcet;
+        }
+    }
+
+    return has;
+}
+
+
+/* Checks the two periodic jobs with the idle gap after each one */
+static bool mtb_pwrconv_sched_pair(mtb_stc_pwrconv_sched_job_t const * a, mtb_stc_pwrconv_sched_job_t const * b,
+                                   uint32_t gap)
+{
+    uint32_t g  = mtb_pwrconv_sched_gcd(a->period, b->period);
+    uint32_t ca = a->len + gap;
+    uint32_t cb = b->len + gap;
+    uint32_t d  = ((b->start % g) + g - (a->start % g)) % g; /* The shift of b after a */
+
+    /* The b job starts after the a job end and ends before the next a job start */
+    return ((ca + cb) <= g) && (ca <= d) && (d <= (g - cb));
+}
+
+
+/* Checks the instance ISRs with the PWM period started at ofs against all the already placed ones */
+static bool mtb_pwrconv_sched_fits(mtb_stc_pwrconv_sched_srch_t const * srch, uint32_t idx, uint32_t ofs)
+{
+    bool fits = true;
+    mtb_stc_pwrconv_sched_job_t a;
+    mtb_stc_pwrconv_sched_job_t b;
+    uint32_t jdx;
+    uint32_t ja;
+    uint32_t jb;
+
+    for (jdx = 0UL; fits && (jdx < srch->num); jdx++)
+    {
+        if (0UL != (srch->placed & (1UL << jdx)))
+        {
+            for (ja = 0UL; fits && mtb_pwrconv_sched_job(&srch->sched[idx], ja, ofs, &a); ja++)
+            {
+                for (jb = 0UL; fits && mtb_pwrconv_sched_job(&srch->sched[jdx], jb, srch->ofs[jdx], &b); jb++)
+                {
+                    fits = mtb_pwrconv_sched_pair(&a, &b, srch->gap);
+                }
+            }
+        }
+    }
+
+    return fits;
+}
+
+
+static bool mtb_pwrconv_sched_search(mtb_stc_pwrconv_sched_srch_t * srch, uint32_t cnt);
+
+
+/* Tries the shifts ofs = base + k * g of the instance, returns true when the rest instances are placed too */
+static bool mtb_pwrconv_sched_place(mtb_stc_pwrconv_sched_srch_t * srch, uint32_t cnt, uint32_t idx,
+                                    uint32_t base, uint32_t g)
+{
+    bool found = false;
+    uint32_t ofs;
+
+    for (ofs = base % g; (!found) && (ofs < srch->sched[idx].period); ofs += g)
+    {
+        if (mtb_pwrconv_sched_fits(srch, idx, ofs))
+        {
+            srch->ofs[idx] = ofs;
+            srch->placed |= (1UL << idx);
+            found = mtb_pwrconv_sched_search(srch, cnt + 1UL);
+            if (!found)
+            {
+                srch->placed &= ~(1UL << idx);
+            }
+        }
+    }
+
+    return found;
+}
+
+
+/* Places the rest instances. Any valid schedule can be shifted until every instance
+ * touches some other one or reaches the shift, where its first ISR moves to the next period
+ * (zero or period - delay), so only such shifts are tried.
+ * The recursion depth is limited by MTB_PWRCONV_SCHED_MAX.
+ */
+static bool mtb_pwrconv_sched_search(mtb_stc_pwrconv_sched_srch_t * srch, uint32_t cnt)
+{
+    bool found = (cnt >= srch->num);
+    mtb_stc_pwrconv_sched_job_t a;
+    mtb_stc_pwrconv_sched_job_t b;
+    uint32_t idx;
+    uint32_t jdx;
+    uint32_t ja;
+    uint32_t jb;
+    uint32_t side;
+
+    for (idx = 0UL; (!found) && (idx < srch->num); idx++)
+    {
+        if (0UL == (srch->placed & (1UL << idx)))
+        {
+            mtb_stc_pwrconv_sched_t const * task = &srch->sched[idx];
+
+            found = mtb_pwrconv_sched_place(srch, cnt, idx, 0UL, task->period);
+            if (!found)
+            {
+                found = mtb_pwrconv_sched_place(srch, cnt, idx, task->period - task->delay, task->period);
+            }
+
+            for (jdx = 0UL; (!found) && (jdx < srch->num); jdx++)
+            {
+                if (0UL != (srch->placed & (1UL << jdx)))
+                {
+                    for (ja = 0UL; (!found) && mtb_pwrconv_sched_job(task, ja, 0UL, &a); ja++)
+                    {
+                        for (jb = 0UL; (!found) && mtb_pwrconv_sched_job(&srch->sched[jdx], jb, srch->ofs[jdx], &b);
+                             jb++)
+                        {
+                            uint32_t g  = mtb_pwrconv_sched_gcd(a.period, b.period);
+                            uint32_t ob = b.start % g;
+                            uint32_t cb = (b.len + srch->gap) % g;
+                            uint32_t ca = (a.len + srch->gap) % g;
+                            uint32_t oa = (a.start - task->delay) % g; /* The job start without the delay */
+
+                            for (side = 0UL; (!found) && (side < 2UL); side++)
+                            {
+                                /* The a job right after or right before the b one */
+                                uint32_t targ = (0UL == side) ? ((ob + cb) % g) : ((ob + g - ca) % g);
+                                uint32_t base = (targ + (2UL * g) - oa - (task->delay % g)) % g;
+
+                                /* Both before and after the first ISR moves to the next period */
+                                found = mtb_pwrconv_sched_place(srch, cnt, idx, base, g);
+                                if (!found)
+                                {
+                                    found = mtb_pwrconv_sched_place(srch, cnt, idx, base + task->period, g);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+
+static bool mtb_pwrconv_sched_try(mtb_stc_pwrconv_sched_srch_t * srch, uint32_t gap)
+{
+    bool found = true;
+    mtb_stc_pwrconv_sched_job_t a;
+    mtb_stc_pwrconv_sched_job_t b;
+    uint32_t idx;
+    uint32_t jdx;
+    uint32_t ja;
+    uint32_t jb;
+
+    /* Every pair of jobs should fit into its common period first, this cuts off the hopeless searches */
+    for (idx = 0UL; found && (idx < srch->num); idx++)
+    {
+        for (jdx = idx + 1UL; found && (jdx < srch->num); jdx++)
+        {
+            for (ja = 0UL; found && mtb_pwrconv_sched_job(&srch->sched[idx], ja, 0UL, &a); ja++)
+            {
+                for (jb = 0UL; found && mtb_pwrconv_sched_job(&srch->sched[jdx], jb, 0UL, &b); jb++)
+                {
+                    found = ((a.len + b.len + (2UL * gap)) <= mtb_pwrconv_sched_gcd(a.period, b.period));
+                }
+            }
+        }
+    }
+
+    if (found)
+    {
+        srch->gap = gap;
+        srch->placed = 0UL;
+        found = mtb_pwrconv_sched_search(srch, 0UL);
+    }
+
+    return found;
+}
+
+
+cy_rslt_t mtb_pwrconv_sched_calc(mtb_stc_pwrconv_sched_t sched[], uint32_t num)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+    mtb_stc_pwrconv_sched_srch_t srch;
+    uint32_t lo = 0UL;
+    uint32_t hi = 0xFFFFFFFFUL;
+    uint32_t idx;
+
+    if ((NULL == sched) || (0UL == num) || (MTB_PWRCONV_SCHED_MAX < num))
+    {
+        rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+    }
+
+    for (idx = 0UL; (MTB_PWRCONV_RSLT_SUCCESS == rslt) && (idx < num); idx++)
+    {
+        if ((0UL == sched[idx].wcet) || (sched[idx].wcet >= sched[idx].period) ||
+            (sched[idx].delay >= sched[idx].period) ||
+            ((1UL < sched[idx].div) && ((0UL == sched[idx].light) || (sched[idx].light > sched[idx].wcet))))
+        {
+            rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+        }
+        else if (hi > sched[idx].period)
+        {
+            hi = sched[idx].period;
+        }
+        else
+        {
+            /* The shortest period is already found */
+        }
+    }
+
+    if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
+    {
+        srch.sched = sched;
+        srch.num = num;
+
+        if (!mtb_pwrconv_sched_try(&srch, 0UL))
+        {
+            rslt = MTB_PWRCONV_RSLT_NO_SCHEDULE;
+        }
+        else
+        {
+            /* The bisection of the largest idle gap between the ISRs */
+            while (lo < hi)
+            {
+                uint32_t mid = lo + ((hi - lo + 1UL) / 2UL);
+
+                if (mtb_pwrconv_sched_try(&srch, mid))
+                {
+                    lo = mid;
+                }
+                else
+                {
+                    hi = mid - 1UL;
+                }
+            }
+
+            (void)mtb_pwrconv_sched_try(&srch, lo);
+
+            for (idx = 0UL; idx < num; idx++)
+            {
+                /* The counter started ahead by the phase value triggers the ISR earlier by that time */
+                sched[idx].phase = (sched[idx].period - srch.ofs[idx]) % sched[idx].period;
+            }
+        }
+    }
+
+    return rslt;
+}
+
+
+/* [] END OF FILE */
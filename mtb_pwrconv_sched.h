@@ -0,0 +1,124 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_sched.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion control loop ISR scheduler.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_sched Control loop ISR scheduler
+ */
+
+#ifndef MTB_PWRCONV_SCHED_H
+#define MTB_PWRCONV_SCHED_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_sched
+ * \{
+ */
+
+/** The maximal number of the scheduled instances */
+#define MTB_PWRCONV_SCHED_MAX   (4U)
+
+/** The scheduler task structure, one per power converter instance */
+typedef struct
+{
+    uint32_t period; /**< The control loop ISR period, PWM clock cycles, typically myPwrConv_PWM_PERIOD */
+    uint32_t   wcet; /**< The control loop ISR worst-case execution time including the entry/exit latency,
+                      *   PWM clock cycles, typically myPwrConv_ISR_WCET. For the decimated instance
+                      *   this is the time of the ISR executing the regulator.
+                      */
+    uint32_t  light; /**< The worst-case execution time of the decimated ISR, which only accumulates the feedback,
+                      *   PWM clock cycles, typically myPwrConv_ISR_WCET_LIGHT, ignored when div is 0 or 1
+                      */
+    uint32_t    div; /**< The regulator decimation factor, typically myPwrConv_FAST_DIV,
+                      *   0 or 1 when the regulator is executed every period
+                      */
+    uint32_t  delay; /**< The ISR start delay from the PWM period start (the ADC trigger position and
+                      *   the conversion time), PWM clock cycles, typically myPwrConv_ISR_DELAY
+                      */
+    uint32_t  phase; /**< The calculated initial PWM counter value, the myPwrConv_set_phase() parameter */
+} mtb_stc_pwrconv_sched_t;
+
+/** Calculates the initial PWM counter values of several instances so that their control loop ISRs never overlap
+ *
+ * The ISRs of two instances with the periods T1 and T2 repeat with the relative shift modulo gcd(T1, T2),
+ * so they never overlap when this shift leaves room for both execution times.
+ * The ISR of the instance with the \ref section_pwrconv_multirate executes the regulator (\p wcet)
+ * only every \p div periods and the short accumulating path (\p light) in the rest periods,
+ * so it is modelled as two periodic ISRs with the periods T and div * T.
+ * The regulator is executed in the div-th ISR after the synchronous start,
+ * as the feedback accumulator is reset by the instance initialization and disabling.
+ * The ISR starts \p delay after the PWM period start, so the instances with different
+ * ADC trigger positions are also scheduled correctly.
+ * The scheduler searches the shifts of all the instances exhaustively,
+ * so it either finds a schedule or proves that none exists. The tools/sched_check host tool confirms this
+ * against the brute-force ISR timeline simulation of the random configurations, see tools/README.md.
+ * Among the valid schedules, the one with the maximal minimal idle gap between any two ISRs is chosen,
+ * which gives the most tolerance to the execution time uncertainty.
+ *
+ * The instances should be clocked by the same PWM clock and started synchronously by pwrconv_start(),
+ * the \ref mtb_stc_pwrconv_sched_t::phase values are applied by myPwrConv_set_phase() before it.
+ * The calculation takes a variable time, so it is intended for the initialization, not for the control loop.
+ *
+ * @param[in,out] sched  The array of the task structures: the periods, execution times, decimation and delays
+ *                       as inputs, the calculated phases as outputs.
+ * @param[in] num        The number of the instances, up to \ref MTB_PWRCONV_SCHED_MAX.
+ * @return               The scheduling status \ref group_pwrconv_status
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the phases are calculated,
+ *                       - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - zero or too many instances, zero period,
+ *                         execution time is zero or not shorter than the period,
+ *                         the decimated ISR light path time is zero or longer than the execution time,
+ *                         or the delay is not shorter than the period,
+ *                       - \ref MTB_PWRCONV_RSLT_NO_SCHEDULE - the ISRs overlap at any phases,
+ *                         the phases are not changed.
+ */
+cy_rslt_t mtb_pwrconv_sched_calc(mtb_stc_pwrconv_sched_t sched[], uint32_t num);
+
+
+/** \} group_pwrconv_sched */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_SCHED_H */
+
+/* [] END OF FILE */
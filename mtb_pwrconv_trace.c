@@ -0,0 +1,108 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_trace.c
+* \version 1.0
+* \brief Provides API implementation for the Power Conversion control loop trace recorder.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "mtb_pwrconv_trace.h"
+#include <string.h>
+
+cy_rslt_t mtb_pwrconv_trace_init(mtb_stc_pwrconv_trace_ctx_t * ctx, mtb_stc_pwrconv_trace_cfg_t const * cfg)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+
+    if ((NULL == cfg->buf) || (0UL == cfg->size) ||
+        (0UL != (cfg->size & (cfg->size - 1UL))) || (cfg->post >= cfg->size))
+    {
+        rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+    }
+    else
+    {
+        (void)memset(&ctx->dat, 0, sizeof(ctx->dat));
+        ctx->cfg = *cfg;
+        ctx->dat.ref = 0xFFFFFFFFUL; /* Record the reference at the first cycle */
+    }
+
+    return rslt;
+}
+
+
+void mtb_pwrconv_trace_event(mtb_stc_pwrconv_trace_ctx_t * ctx, uint32_t code, uint32_t val, bool trig)
+{
+    ctx->dat.evtCode = code;
+    ctx->dat.evtVal  = val;
+    __DMB(); /* The event should be written before it is announced */
+    ctx->dat.evtSeq++;
+
+    if (trig)
+    {
+        ctx->dat.trig = 1UL; /* Sticky, so the next event does not cancel it before it is recorded */
+    }
+}
+
+
+void mtb_pwrconv_trace_stop(mtb_stc_pwrconv_trace_ctx_t * ctx)
+{
+    ctx->dat.fin = true;
+    __DMB(); /* The request should be visible to the preempted cycle before the check below */
+
+    if (!ctx->dat.busy)
+    {
+        mtb_pwrconv_trace_pending(ctx);
+        ctx->dat.state = MTB_PWRCONV_TRACE_STOP;
+    }
+}
+
+
+void mtb_pwrconv_trace_get_header(mtb_stc_pwrconv_trace_ctx_t const * ctx, mtb_stc_pwrconv_trace_hdr_t * hdr)
+{
+    hdr->magic   = MTB_PWRCONV_TRACE_MAGIC;
+    hdr->version = MTB_PWRCONV_TRACE_VERSION;
+    hdr->recSize = (uint16_t)sizeof(mtb_stc_pwrconv_trace_rec_t);
+    hdr->num     = (ctx->dat.head < ctx->cfg.size) ? ctx->dat.head : ctx->cfg.size;
+    hdr->freq    = ctx->cfg.freq;
+}
+
+
+mtb_stc_pwrconv_trace_rec_t const * mtb_pwrconv_trace_get_rec(mtb_stc_pwrconv_trace_ctx_t const * ctx, uint32_t idx)
+{
+    /* The oldest record is at the head when the ring buffer is full */
+    uint32_t first = (ctx->dat.head < ctx->cfg.size) ? 0UL : ctx->dat.head;
+
+    return &ctx->cfg.buf[(first + idx) & (ctx->cfg.size - 1UL)];
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,334 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_trace.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion control loop trace recorder.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_trace Control loop trace recorder
+ */
+
+#ifndef MTB_PWRCONV_TRACE_H
+#define MTB_PWRCONV_TRACE_H
+
+#include "mtb_pwrconv.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_trace
+ * \{
+ */
+
+/** The trace file header magic number, "PCTR" */
+#define MTB_PWRCONV_TRACE_MAGIC     (0x52544350UL)
+/** The trace format version */
+#define MTB_PWRCONV_TRACE_VERSION   (1U)
+
+/** The trace record types */
+#define MTB_PWRCONV_TRACE_RES       (0UL) /**< The feedback \ref mtb_stc_pwrconv_ctx_t::res, starts a cycle */
+#define MTB_PWRCONV_TRACE_MOD       (1UL) /**< The modulator \ref mtb_stc_pwrconv_ctx_t::mod at the cycle end */
+#define MTB_PWRCONV_TRACE_REF       (2UL) /**< The reference \ref mtb_stc_pwrconv_ctx_t::ref, recorded when changed */
+#define MTB_PWRCONV_TRACE_CHAN      (3UL) /**< The scheduled channel result, the id is the channel index */
+#define MTB_PWRCONV_TRACE_EVENT     (4UL) /**< The user event, the id is the event code */
+
+/** The record tag fields */
+#define MTB_PWRCONV_TRACE_TICK_Msk  (0x00FFFFFFUL) /**< The control loop cycle number, wraps around */
+#define MTB_PWRCONV_TRACE_TYPE_Pos  (24U)          /**< The record type position */
+#define MTB_PWRCONV_TRACE_TYPE_Msk  (0x0F000000UL) /**< The record type mask */
+#define MTB_PWRCONV_TRACE_ID_Pos    (28U)          /**< The record id position */
+#define MTB_PWRCONV_TRACE_ID_Msk    (0xF0000000UL) /**< The record id mask */
+
+/** The maximal number of the traced scheduled channels */
+#define MTB_PWRCONV_TRACE_CHAN_MAX  (4U)
+
+/** The trace states */
+#define MTB_PWRCONV_TRACE_RUN       (0UL) /**< Recording, the oldest records are overwritten */
+#define MTB_PWRCONV_TRACE_TRIG      (1UL) /**< Triggered, recording the post-trigger records */
+#define MTB_PWRCONV_TRACE_STOP      (2UL) /**< Stopped, the records are ready to be read */
+
+/** The trace record, also the trace file record */
+typedef struct
+{
+    uint32_t tag; /**< The cycle number, type and id, see \ref MTB_PWRCONV_TRACE_TICK_Msk */
+    uint32_t val; /**< The recorded value */
+} mtb_stc_pwrconv_trace_rec_t;
+
+/** The trace file header, followed by the records in the chronological order */
+typedef struct
+{
+    uint32_t   magic; /**< \ref MTB_PWRCONV_TRACE_MAGIC */
+    uint16_t version; /**< \ref MTB_PWRCONV_TRACE_VERSION */
+    uint16_t recSize; /**< The record size, bytes */
+    uint32_t     num; /**< The number of the records */
+    uint32_t    freq; /**< The control loop frequency, Hz */
+} mtb_stc_pwrconv_trace_hdr_t;
+
+/** The trace configuration structure */
+typedef struct
+{
+    mtb_stc_pwrconv_trace_rec_t * buf; /* The ring buffer */
+    uint32_t size;                     /* The ring buffer size in records, a power of two */
+    uint32_t post;                     /* The number of the records after the trigger */
+    uint32_t freq;                     /* The control loop frequency, Hz */
+} mtb_stc_pwrconv_trace_cfg_t;
+
+/** The trace internal data structure */
+typedef struct
+{
+    uint32_t head;                                  /* The number of the written records */
+    uint32_t tick;                                  /* The control loop cycle counter */
+    uint32_t ref;                                   /* The last recorded reference */
+    uint32_t refHead;                               /* The head at the last reference record */
+    uint32_t post;                                  /* The remaining post-trigger records */
+    uint32_t state;                                 /* The trace state */
+    uint32_t chanVal[MTB_PWRCONV_TRACE_CHAN_MAX];   /* The scheduled channel results mailbox */
+    uint32_t chanSeq[MTB_PWRCONV_TRACE_CHAN_MAX];   /* Incremented by the writer after the result */
+    uint32_t chanAck[MTB_PWRCONV_TRACE_CHAN_MAX];   /* The last recorded sequence */
+    uint32_t evtCode;                               /* The event mailbox: code and value */
+    uint32_t evtVal;
+    uint32_t evtSeq;                                /* Incremented by the writer after the event */
+    uint32_t evtAck;                                /* The last recorded sequence */
+    volatile uint32_t trig;                         /* The sticky trigger request, not overwritten by the events */
+    volatile bool busy;                             /* The control loop cycle is being recorded */
+    volatile bool fin;                              /* The stop request, see mtb_pwrconv_trace_stop() */
+} mtb_stc_pwrconv_trace_dat_t;
+
+/** The trace working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_trace_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_trace_dat_t dat; /* The trace internal data */
+} mtb_stc_pwrconv_trace_ctx_t;
+
+/** Initialize the trace and start recording
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @return               The initialization status
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the trace is started,
+ *                       - \ref MTB_PWRCONV_RSLT_INVALID_PARAM - no buffer, the size is not a power of two
+ *                         or the post-trigger number is above it.
+ */
+cy_rslt_t mtb_pwrconv_trace_init(mtb_stc_pwrconv_trace_ctx_t * ctx, mtb_stc_pwrconv_trace_cfg_t const * cfg);
+
+/** Writes a record into the ring buffer, the records are overwritten after the trigger
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] type       The record type, \ref MTB_PWRCONV_TRACE_RES etc.
+ * @param[in] id         The record id.
+ * @param[in] val        The recorded value.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_trace_put(mtb_stc_pwrconv_trace_ctx_t * ctx,
+                                                uint32_t type, uint32_t id, uint32_t val)
+{
+    if (MTB_PWRCONV_TRACE_STOP != ctx->dat.state)
+    {
+        mtb_stc_pwrconv_trace_rec_t * rec = &ctx->cfg.buf[ctx->dat.head & (ctx->cfg.size - 1UL)];
+
+        rec->tag = (ctx->dat.tick & MTB_PWRCONV_TRACE_TICK_Msk) |
+                   ((type << MTB_PWRCONV_TRACE_TYPE_Pos) & MTB_PWRCONV_TRACE_TYPE_Msk) |
+                   ((id << MTB_PWRCONV_TRACE_ID_Pos) & MTB_PWRCONV_TRACE_ID_Msk);
+        rec->val = val;
+        ctx->dat.head++;
+
+        if (MTB_PWRCONV_TRACE_TRIG == ctx->dat.state)
+        {
+            if (0UL == ctx->dat.post)
+            {
+                ctx->dat.state = MTB_PWRCONV_TRACE_STOP;
+            }
+            else
+            {
+                ctx->dat.post--;
+            }
+        }
+    }
+}
+
+/** Records the pending scheduled channel results and events, and triggers the trace on the trigger request
+ *
+ * Called by \ref mtb_pwrconv_trace_cycle and \ref mtb_pwrconv_trace_stop.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_trace_pending(mtb_stc_pwrconv_trace_ctx_t * ctx)
+{
+    uint32_t idx;
+
+    for (idx = 0UL; idx < MTB_PWRCONV_TRACE_CHAN_MAX; idx++)
+    {
+        if (ctx->dat.chanAck[idx] != ctx->dat.chanSeq[idx])
+        {
+            ctx->dat.chanAck[idx] = ctx->dat.chanSeq[idx];
+            mtb_pwrconv_trace_put(ctx, MTB_PWRCONV_TRACE_CHAN, idx, ctx->dat.chanVal[idx]);
+        }
+    }
+
+    if (ctx->dat.evtAck != ctx->dat.evtSeq)
+    {
+        ctx->dat.evtAck = ctx->dat.evtSeq;
+        mtb_pwrconv_trace_put(ctx, MTB_PWRCONV_TRACE_EVENT, ctx->dat.evtCode, ctx->dat.evtVal);
+    }
+
+    if ((0UL != ctx->dat.trig) && (MTB_PWRCONV_TRACE_RUN == ctx->dat.state))
+    {
+        ctx->dat.post = ctx->cfg.post;
+        ctx->dat.state = MTB_PWRCONV_TRACE_TRIG;
+    }
+}
+
+/** Stops the trace when the control loop is stopped
+ *
+ * The post-trigger records are not written after the control loop is stopped, so the trace would never
+ * reach \ref MTB_PWRCONV_TRACE_STOP. This function records the pending scheduled channel results and events
+ * (e.g. the triggering fault posted before the disabling) and stops the trace.
+ * Should be called after the control loop ISR is disabled, typically by the generated myPwrConv_disable()
+ * and myPwrConv_disable_warm(). It can be called from the ISR preempting \ref mtb_pwrconv_trace_cycle:
+ * the preempted cycle is completed and stops the trace itself. The trace is restarted by
+ * \ref mtb_pwrconv_trace_init.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ */
+void mtb_pwrconv_trace_stop(mtb_stc_pwrconv_trace_ctx_t * ctx);
+
+/** Records the control loop cycle: the reference when changed, the feedback, the modulator value,
+ *  and the pending scheduled channel results and events.
+ *
+ * All the records are written by this function (and by \ref mtb_pwrconv_trace_stop when the control loop
+ * is stopped), so the ring buffer is accessed from the control loop ISR only.
+ * Should be called once per control loop period, after the regulator.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] pwrconv    The pointer to the power converter instance context structure.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_trace_cycle(mtb_stc_pwrconv_trace_ctx_t * ctx,
+                                                  mtb_stc_pwrconv_ctx_t const * pwrconv)
+{
+    ctx->dat.busy = true;
+    __DMB();
+
+    /* Also repeated every 1/8 of the buffer, so the overwritten buffer still has the reference value */
+    if ((ctx->dat.ref != pwrconv->ref) || ((ctx->dat.head - ctx->dat.refHead) >= (ctx->cfg.size / 8UL)))
+    {
+        ctx->dat.ref = pwrconv->ref;
+        ctx->dat.refHead = ctx->dat.head;
+        mtb_pwrconv_trace_put(ctx, MTB_PWRCONV_TRACE_REF, 0UL, pwrconv->ref);
+    }
+
+    mtb_pwrconv_trace_put(ctx, MTB_PWRCONV_TRACE_RES, 0UL, pwrconv->res);
+    mtb_pwrconv_trace_put(ctx, MTB_PWRCONV_TRACE_MOD, 0UL, pwrconv->mod);
+    mtb_pwrconv_trace_pending(ctx);
+    ctx->dat.tick++;
+
+    ctx->dat.busy = false;
+    __DMB();
+    if (ctx->dat.fin)
+    {
+        mtb_pwrconv_trace_stop(ctx); /* The stop request preempted this cycle, it is completed here */
+    }
+}
+
+/** Passes the scheduled channel result to the next \ref mtb_pwrconv_trace_cycle call
+ *
+ * Typically called by the scheduled ADC group callback. Only one context should write one channel.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] idx        The channel index, less than \ref MTB_PWRCONV_TRACE_CHAN_MAX.
+ * @param[in] val        The channel result.
+ */
+__STATIC_FORCEINLINE void mtb_pwrconv_trace_chan(mtb_stc_pwrconv_trace_ctx_t * ctx, uint32_t idx, uint32_t val)
+{
+    ctx->dat.chanVal[idx] = val;
+    __DMB(); /* The value should be written before it is announced */
+    ctx->dat.chanSeq[idx]++;
+}
+
+/** Passes the user event to the next \ref mtb_pwrconv_trace_cycle call, optionally triggering the trace
+ *
+ * After the trigger, the configured number of the records is written and the trace stops,
+ * so the buffer keeps the history before the event (e.g. a fault) and after it.
+ * Only one context should write the events. The event not recorded yet is overwritten by the next one,
+ * but the trigger request is sticky: it is kept until the trace is restarted by \ref mtb_pwrconv_trace_init.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] code       The event code, 0..15.
+ * @param[in] val        The event data.
+ * @param[in] trig       True to trigger the trace.
+ */
+void mtb_pwrconv_trace_event(mtb_stc_pwrconv_trace_ctx_t * ctx, uint32_t code, uint32_t val, bool trig);
+
+/** Returns the trace state
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               The trace state: \ref MTB_PWRCONV_TRACE_RUN, \ref MTB_PWRCONV_TRACE_TRIG
+ *                       or \ref MTB_PWRCONV_TRACE_STOP.
+ */
+__STATIC_INLINE uint32_t mtb_pwrconv_trace_get_state(mtb_stc_pwrconv_trace_ctx_t const * ctx)
+{
+    return ctx->dat.state;
+}
+
+/** Fills the trace file header for the stopped trace
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[out] hdr       The pointer to the trace file header.
+ */
+void mtb_pwrconv_trace_get_header(mtb_stc_pwrconv_trace_ctx_t const * ctx, mtb_stc_pwrconv_trace_hdr_t * hdr);
+
+/** Returns the record of the stopped trace in the chronological order
+ *
+ * The trace file is the header from \ref mtb_pwrconv_trace_get_header followed by the records
+ * for the indexes from zero to mtb_stc_pwrconv_trace_hdr_t::num - 1,
+ * e.g. sent by UART or saved by a debugger, and replayed on the host by the tools/trace_replay tool.
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[in] idx        The record index, zero is the oldest one.
+ * @return               The pointer to the record.
+ */
+mtb_stc_pwrconv_trace_rec_t const * mtb_pwrconv_trace_get_rec(mtb_stc_pwrconv_trace_ctx_t const * ctx, uint32_t idx);
+
+
+/** \} group_pwrconv_trace */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_TRACE_H */
+
+/* [] END OF FILE */
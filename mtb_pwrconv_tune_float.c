@@ -0,0 +1,163 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_tune_float.c
+* \version 1.0
+* \brief Provides API implementation for the Power Conversion floating point relay auto-tuning.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "mtb_pwrconv_tune_float.h"
+#include <string.h>
+#include <math.h>
+
+/* The PID with the filtered derivative coefficients, backward Euler discretization */
+typedef struct
+{
+    float32_t a[3];
+    float32_t b[3];
+} mtb_stc_pwrconv_tune_float_pid_t;
+
+static cy_rslt_t mtb_pwrconv_tune_float_pid(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                            mtb_stc_pwrconv_tune_float_pid_t * pid);
+
+
+cy_rslt_t mtb_pwrconv_tune_float_start(mtb_stc_pwrconv_tune_float_ctx_t * ctx,
+                                       mtb_stc_pwrconv_tune_float_cfg_t const * cfg, uint32_t bias)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_SUCCESS;
+
+    if ((NULL == ctx) || (NULL == cfg) || (0UL == cfg->periods) || (0.0f >= cfg->amp) || (0.0f >= cfg->ts))
+    {
+        rslt = MTB_PWRCONV_RSLT_INVALID_PARAM;
+    }
+    else
+    {
+        ctx->dat.state = MTB_PWRCONV_TUNE_IDLE; /* Stop the relay while its data is being reset */
+        __DMB();
+
+        ctx->cfg = *cfg;
+        (void)memset(&ctx->dat, 0, sizeof(ctx->dat));
+        ctx->dat.bias = (float32_t)bias;
+
+        __DMB();
+        ctx->dat.state = MTB_PWRCONV_TUNE_ACTIVE;
+    }
+
+    return rslt;
+}
+
+
+void mtb_pwrconv_tune_float_stop(mtb_stc_pwrconv_tune_float_ctx_t * ctx)
+{
+    __DMB(); /* The regulator update should be completed before it takes the control */
+    ctx->dat.state = MTB_PWRCONV_TUNE_IDLE;
+}
+
+
+static cy_rslt_t mtb_pwrconv_tune_float_pid(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                            mtb_stc_pwrconv_tune_float_pid_t * pid)
+{
+    cy_rslt_t rslt = MTB_PWRCONV_RSLT_TUNE_FAIL;
+
+    if (MTB_PWRCONV_TUNE_DONE == ctx->dat.state)
+    {
+        /* The relay keeps oscillating after the measurement, so the edges counter is not used:
+         * exactly the configured number of the periods is accumulated when the state is DONE
+         */
+        float32_t periods = (float32_t)ctx->cfg.periods;
+        float32_t a  = 0.5f * (float32_t)ctx->dat.ampSum / periods; /* The oscillation amplitude */
+        float32_t h  = (float32_t)ctx->cfg.hyst;
+
+        if (a > h)
+        {
+            /* The ultimate gain and period by the describing function of the relay with hysteresis */
+            float32_t ku = (4.0f * ctx->cfg.amp) / (3.14159265f * sqrtf((a * a) - (h * h)));
+            float32_t tu = ctx->cfg.ts * (float32_t)ctx->dat.perSum / periods;
+
+            float32_t kp = ctx->cfg.kp * ku;
+            float32_t ki = ctx->cfg.ts / (ctx->cfg.ti * tu);
+            float32_t td = ctx->cfg.td * tu;
+            float32_t tf = (0.0f < ctx->cfg.n) ? (td / ctx->cfg.n) : 0.0f;
+            float32_t p  = tf / (tf + ctx->cfg.ts); /* The derivative filter pole */
+            float32_t kd = td / (tf + ctx->cfg.ts);
+
+            pid->a[0] = 0.0f;
+            pid->a[1] = 1.0f + p;
+            pid->a[2] = -p;
+            pid->b[0] = kp * (1.0f + ki + kd);
+            pid->b[1] = -kp * (1.0f + p + (ki * p) + (2.0f * kd));
+            pid->b[2] = kp * (p + kd);
+
+            rslt = MTB_PWRCONV_RSLT_SUCCESS;
+        }
+    }
+
+    return rslt;
+}
+
+
+cy_rslt_t mtb_pwrconv_tune_float_get_2p2z(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                          mtb_stc_pwrconv_reg_2p2z_float_cfg_t * cfg)
+{
+    mtb_stc_pwrconv_tune_float_pid_t pid;
+    cy_rslt_t rslt = mtb_pwrconv_tune_float_pid(ctx, &pid);
+
+    if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
+    {
+        (void)memcpy(cfg->a, pid.a, sizeof(pid.a));
+        (void)memcpy(cfg->b, pid.b, sizeof(pid.b));
+    }
+
+    return rslt;
+}
+
+
+cy_rslt_t mtb_pwrconv_tune_float_get_3p3z(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                          mtb_stc_pwrconv_reg_3p3z_float_cfg_t * cfg)
+{
+    mtb_stc_pwrconv_tune_float_pid_t pid;
+    cy_rslt_t rslt = mtb_pwrconv_tune_float_pid(ctx, &pid);
+
+    if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
+    {
+        (void)memcpy(cfg->a, pid.a, sizeof(pid.a));
+        (void)memcpy(cfg->b, pid.b, sizeof(pid.b));
+        cfg->a[3] = 0.0f;
+        cfg->b[3] = 0.0f;
+    }
+
+    return rslt;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,248 @@
+/***************************************************************************//**
+* \file mtb_pwrconv_tune_float.h
+* \version 1.0
+* \brief Provides API declarations for the Power Conversion floating point relay auto-tuning.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+/**
+ * \defgroup group_pwrconv_tune_float Relay feedback auto-tuning
+ */
+
+#ifndef MTB_PWRCONV_TUNE_FLOAT_H
+#define MTB_PWRCONV_TUNE_FLOAT_H
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_3p3z_float.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \addtogroup group_pwrconv_tune_float
+ * \{
+ */
+
+/** The auto-tuning states */
+#define MTB_PWRCONV_TUNE_IDLE   (0UL) /**< The auto-tuning is not running, the regulator controls the modulator */
+#define MTB_PWRCONV_TUNE_ACTIVE (1UL) /**< The relay controls the modulator, the oscillation is being measured */
+#define MTB_PWRCONV_TUNE_DONE   (2UL) /**< The measurement is completed, the relay still controls the modulator */
+#define MTB_PWRCONV_TUNE_FAIL   (3UL) /**< No stable oscillation within the timeout,
+                                      *   the relay still controls the modulator */
+
+/** The classic Ziegler-Nichols PID tuning rule factors */
+#define MTB_PWRCONV_TUNE_ZN_KP  (0.6f)   /**< Proportional gain per ultimate gain */
+#define MTB_PWRCONV_TUNE_ZN_TI  (0.5f)   /**< Integral time per ultimate period */
+#define MTB_PWRCONV_TUNE_ZN_TD  (0.125f) /**< Derivative time per ultimate period */
+
+/** The auto-tuning configuration structure */
+typedef struct
+{
+    float32_t amp;     /* The relay amplitude, modulator counts */
+    int32_t   hyst;    /* The relay hysteresis, error ADC counts */
+    float32_t min;     /* Lower modulator limit */
+    float32_t max;     /* Upper modulator limit */
+    uint32_t  skip;    /* The number of the relay periods skipped to let the oscillation settle */
+    uint32_t  periods; /* The number of the relay periods to be averaged */
+    uint32_t  timeout; /* The maximal measurement duration, control loop periods */
+    float32_t ts;      /* The control loop sampling period, seconds */
+    float32_t kp;      /* The proportional gain per ultimate gain */
+    float32_t ti;      /* The integral time per ultimate period */
+    float32_t td;      /* The derivative time per ultimate period */
+    float32_t n;       /* The derivative filter ratio: the filter time constant is td / n */
+} mtb_stc_pwrconv_tune_float_cfg_t;
+
+/** The auto-tuning internal data structure */
+typedef struct
+{
+    uint32_t  state;   /* The auto-tuning state */
+    float32_t bias;    /* The modulator value at the auto-tuning start */
+    bool      high;    /* The relay output */
+    uint32_t  edges;   /* The relay rising edges counter */
+    uint32_t  tick;    /* The control loop periods counter */
+    uint32_t  cnt;     /* The current relay period duration, control loop periods */
+    int32_t   errMax;  /* The current relay period error maximum */
+    int32_t   errMin;  /* The current relay period error minimum */
+    uint32_t  perSum;  /* The measured relay periods sum */
+    uint32_t  ampSum;  /* The measured error peak-to-peak sum */
+} mtb_stc_pwrconv_tune_float_dat_t;
+
+/** The auto-tuning working context data structure */
+typedef struct
+{
+    mtb_stc_pwrconv_tune_float_cfg_t cfg; /* The configuration parameters */
+    mtb_stc_pwrconv_tune_float_dat_t dat; /* The auto-tuning internal data */
+} mtb_stc_pwrconv_tune_float_ctx_t;
+
+/** Starts the auto-tuning
+ *
+ * From the next control loop period the relay replaces the regulator.
+ * The relay output is the \p bias modulator value plus/minus the relay amplitude.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] cfg        The pointer to the configuration structure.
+ * @param[in] bias       The relay center modulator value - typically, the current \ref mtb_stc_pwrconv_ctx_t::mod
+ *                       in the steady state.
+ * @return               The operation status.
+ */
+cy_rslt_t mtb_pwrconv_tune_float_start(mtb_stc_pwrconv_tune_float_ctx_t * ctx,
+                                       mtb_stc_pwrconv_tune_float_cfg_t const * cfg, uint32_t bias);
+
+/** Stops the auto-tuning, from the next control loop period the regulator controls the modulator again.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ */
+void mtb_pwrconv_tune_float_stop(mtb_stc_pwrconv_tune_float_ctx_t * ctx);
+
+/** Calculates the 2P2Z regulator coefficients (PID with the filtered derivative)
+ * from the measured relay oscillation.
+ *
+ * Only the \ref mtb_stc_pwrconv_reg_2p2z_float_cfg_t::a and \ref mtb_stc_pwrconv_reg_2p2z_float_cfg_t::b
+ * coefficients are updated, the anti-windup limits are kept.
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[in,out] cfg    The pointer to the regulator configuration structure to be updated.
+ * @return               The operation status:
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the coefficients are calculated,
+ *                       - \ref MTB_PWRCONV_RSLT_TUNE_FAIL - the measurement is not completed or failed.
+ */
+cy_rslt_t mtb_pwrconv_tune_float_get_2p2z(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                          mtb_stc_pwrconv_reg_2p2z_float_cfg_t * cfg);
+
+/** Calculates the 3P3Z regulator coefficients (PID with the filtered derivative,
+ * the third pole and zero are unused) from the measured relay oscillation.
+ *
+ * Only the \ref mtb_stc_pwrconv_reg_3p3z_float_cfg_t::a and \ref mtb_stc_pwrconv_reg_3p3z_float_cfg_t::b
+ * coefficients are updated, the anti-windup limits are kept.
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @param[in,out] cfg    The pointer to the regulator configuration structure to be updated.
+ * @return               The operation status:
+ *                       - \ref MTB_PWRCONV_RSLT_SUCCESS - the coefficients are calculated,
+ *                       - \ref MTB_PWRCONV_RSLT_TUNE_FAIL - the measurement is not completed or failed.
+ */
+cy_rslt_t mtb_pwrconv_tune_float_get_3p3z(mtb_stc_pwrconv_tune_float_ctx_t const * ctx,
+                                          mtb_stc_pwrconv_reg_3p3z_float_cfg_t * cfg);
+
+/** Returns the auto-tuning state
+ *
+ * @param[in] ctx        The pointer to the data structure, which holds the computation context.
+ * @return               The auto-tuning state: \ref MTB_PWRCONV_TUNE_IDLE, \ref MTB_PWRCONV_TUNE_ACTIVE,
+ *                       \ref MTB_PWRCONV_TUNE_DONE or \ref MTB_PWRCONV_TUNE_FAIL.
+ */
+__STATIC_INLINE uint32_t mtb_pwrconv_tune_float_get_state(mtb_stc_pwrconv_tune_float_ctx_t const * ctx)
+{
+    return ctx->dat.state;
+}
+
+/** Run the relay and measure its oscillation
+ *
+ * Should be called every control loop period instead of the regulator,
+ * the regulator should be executed only when this function returns false.
+ *
+ * @param[out] ctx       The pointer to the data structure, which holds the computation context.
+ * @param[in] input      The error value - typically, \ref mtb_stc_pwrconv_ctx_t::err.
+ * @param[out] output    The pointer to the output data - typically, the pointer to the modulator value.
+ * @return               True when the relay controls the modulator, false when the auto-tuning is idle.
+ */
+__STATIC_FORCEINLINE bool mtb_pwrconv_tune_float_process(mtb_stc_pwrconv_tune_float_ctx_t * ctx,
+                                                         int32_t input, uint32_t * output)
+{
+    bool active = (MTB_PWRCONV_TUNE_IDLE != ctx->dat.state);
+
+    if (active)
+    {
+        float32_t m;
+
+        ctx->dat.cnt++;
+        ctx->dat.errMax = (input > ctx->dat.errMax) ? input : ctx->dat.errMax;
+        ctx->dat.errMin = (input < ctx->dat.errMin) ? input : ctx->dat.errMin;
+
+        if ((!ctx->dat.high) && (input > ctx->cfg.hyst))
+        {
+            /* The relay rising edge - the end of the oscillation period */
+            ctx->dat.high = true;
+
+            if ((MTB_PWRCONV_TUNE_ACTIVE == ctx->dat.state) && (ctx->dat.edges > ctx->cfg.skip))
+            {
+                ctx->dat.perSum += ctx->dat.cnt;
+                ctx->dat.ampSum += (uint32_t)(ctx->dat.errMax - ctx->dat.errMin);
+
+                if ((ctx->dat.edges - ctx->cfg.skip) >= ctx->cfg.periods)
+                {
+                    ctx->dat.state = MTB_PWRCONV_TUNE_DONE;
+                }
+            }
+
+            ctx->dat.edges++;
+            ctx->dat.cnt    = 0UL;
+            ctx->dat.errMax = input;
+            ctx->dat.errMin = input;
+        }
+        else if (ctx->dat.high && (input < -ctx->cfg.hyst))
+        {
+            ctx->dat.high = false;
+        }
+        else
+        {
+            /* Keep the relay output */
+        }
+
+        if ((MTB_PWRCONV_TUNE_ACTIVE == ctx->dat.state) && (++ctx->dat.tick > ctx->cfg.timeout))
+        {
+            ctx->dat.state = MTB_PWRCONV_TUNE_FAIL;
+        }
+
+        m = ctx->dat.high ? (ctx->dat.bias + ctx->cfg.amp) : (ctx->dat.bias - ctx->cfg.amp);
+        m = (m < ctx->cfg.max) ? m : ctx->cfg.max;
+        m = (m > ctx->cfg.min) ? m : ctx->cfg.min;
+
+        *output = (uint32_t)m;
+    }
+
+    return active;
+}
+
+
+/** \} group_pwrconv_tune_float */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTB_PWRCONV_TUNE_FLOAT_H */
+
+/* [] END OF FILE */
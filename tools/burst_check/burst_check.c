@@ -0,0 +1,356 @@
+/***************************************************************************//**
+* \file burst_check.c
+* \version 1.0
+* \brief The host (PC) check of the light-load burst mode entry and exit
+*        against the buck power stage model. See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_burst.h"
+#include "plant_model.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#define PI                  (3.14159265358979323846)
+
+/* The check options */
+typedef struct
+{
+    double   l;                                  /* H */
+    double   c;                                  /* F */
+    double   rl;                                 /* Ohm */
+    double   rc;                                 /* Ohm */
+    double   vin;                                /* V */
+    double   vout;                               /* V */
+    double   fs;                                 /* The control loop sampling frequency, Hz */
+    double   period;                             /* The modulator range, counts */
+    double   scale;                              /* The peak current reference amperes per count */
+    double   k;                                  /* The feedback volts per count */
+    double   bw;                                 /* The regulator crossover frequency, Hz */
+    double   burst[2];                           /* The burst entry threshold and modulator value, % */
+    double   thr[3];                             /* The burst lower, upper and exit thresholds, % */
+    double   time[2];                            /* The burst entry delay and maximal length, us */
+    double   load[2];                            /* The heavy and light loads, A */
+    uint32_t num;                                /* The periods of every load phase */
+    double   tol;                                /* The tolerated steady-state error, counts */
+    FILE   * out;
+} check_t;
+
+/* The PWM outputs gating record */
+static bool     gateOn = true;
+static uint32_t gateCalls = 0U;
+static uint32_t gateBad = 0U;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -L uH,-C uF        the total inductance and the output capacitance\n"
+        "  -r mOhm,-R mOhm    the inductor and the capacitor ESR\n"
+        "  -v Vin,Vout        the input and output voltages\n"
+        "  -f Hz              the control loop sampling frequency (SamplFreq)\n"
+        "  -p counts          the modulator (peak current reference) range\n"
+        "  -a A               the peak current reference amperes per modulator count\n"
+        "  -k V               the feedback volts per ADC count\n"
+        "  -w Hz              the regulator crossover frequency\n"
+        "  -b %%,%%             the burst entry threshold and modulator value, %% of the modulator range\n"
+        "  -h %%,%%,%%          the burst lower, upper and exit thresholds, %% of the target\n"
+        "  -d us,us           the burst entry delay and maximal length\n"
+        "  -i heavy,light     the loads, A: heavy - light - heavy\n"
+        "  -n periods         the periods of every load phase\n"
+        "  -t counts          the tolerated steady-state error at the heavy load\n"
+        "  -o file.csv        write the periods: n,vout,il,err,mod,active,on\n", name);
+}
+
+
+/* The PWM outputs gating function: should be called on the burst start and stop only */
+static void gate(bool on)
+{
+    gateBad += (on == gateOn) ? 1U : 0U;
+    gateOn = on;
+    gateCalls++;
+}
+
+
+int main(int argc, char * argv[])
+{
+    static check_t ck;
+    static mtb_stc_pwrconv_reg_2p2z_float_ctx_t reg;
+    static mtb_stc_pwrconv_burst_ctx_t burst;
+    mtb_stc_pwrconv_reg_2p2z_float_cfg_t regCfg;
+    mtb_stc_pwrconv_burst_cfg_t cfg;
+    mtb_stc_pwrconv_ctx_t ctx;
+    plant_buck_t plant;
+    double list[3];
+    double wc;
+    double kp;
+    double vMin = 1e9;
+    double vMax = 0.0;
+    uint32_t n = 0U;
+    uint32_t entry = 0U;
+    uint32_t exit = 0U;
+    uint32_t exitRun = 0U;
+    uint32_t spurious = 0U;
+    uint32_t bursts = 0U;
+    int32_t errMax = INT32_MIN;
+    int32_t errMin = INT32_MAX;
+    int rslt = EXIT_SUCCESS;
+    int opt;
+
+    ck.l = 2.2e-6;
+    ck.c = 200e-6;
+    ck.rl = 10e-3;
+    ck.rc = 5e-3;
+    ck.vin = 12.0;
+    ck.vout = 3.3;
+    ck.fs = 250e3;
+    ck.period = 1000.0;
+    ck.scale = 0.01;
+    ck.k = 1e-3;
+    ck.bw = 5000.0;
+    ck.burst[0] = 10.0;
+    ck.burst[1] = 10.0;
+    ck.thr[0] = 0.5;
+    ck.thr[1] = 0.5;
+    ck.thr[2] = 2.0;
+    ck.time[0] = 100.0;
+    ck.time[1] = 200.0;
+    ck.load[0] = 5.0;
+    ck.load[1] = 0.2;
+    ck.num = 25000U;
+    ck.tol = 2.0;
+    while (-1 != (opt = getopt(argc, argv, "L:C:r:R:v:f:p:a:k:w:b:h:d:i:n:t:o:")))
+    {
+        switch (opt)
+        {
+            case 'L': ck.l = strtod(optarg, NULL) * 1e-6; break;
+            case 'C': ck.c = strtod(optarg, NULL) * 1e-6; break;
+            case 'r': ck.rl = strtod(optarg, NULL) * 1e-3; break;
+            case 'R': ck.rc = strtod(optarg, NULL) * 1e-3; break;
+            case 'v':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.vin = list[0];
+                    ck.vout = list[1];
+                }
+                break;
+            case 'f': ck.fs = strtod(optarg, NULL); break;
+            case 'p': ck.period = strtod(optarg, NULL); break;
+            case 'a': ck.scale = strtod(optarg, NULL); break;
+            case 'k': ck.k = strtod(optarg, NULL); break;
+            case 'w': ck.bw = strtod(optarg, NULL); break;
+            case 'b': (void)tool_parse_list(optarg, ck.burst, 2); break;
+            case 'h': (void)tool_parse_list(optarg, ck.thr, 3); break;
+            case 'd': (void)tool_parse_list(optarg, ck.time, 2); break;
+            case 'i': (void)tool_parse_list(optarg, ck.load, 2); break;
+            case 'n': ck.num = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': ck.tol = strtod(optarg, NULL); break;
+            case 'o':
+                ck.out = fopen(optarg, "w");
+                if (NULL == ck.out)
+                {
+                    (void)fprintf(stderr, "Can't write %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((ck.l <= 0.0) || (ck.c <= 0.0) || (ck.vin <= ck.vout) || (ck.vout <= 0.0) || (ck.fs <= 0.0) ||
+        (ck.period <= 0.0) || (ck.scale <= 0.0) || (ck.k <= 0.0) || (ck.bw <= 0.0) || (ck.num < 4U) ||
+        (ck.load[1] >= ck.load[0]) || (ck.load[1] < 0.0))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The burst mode configuration the same as by the personality */
+    (void)memset(&ctx, 0, sizeof(ctx));
+    ctx.ref = plant_adc(ck.vout, ck.k, UINT32_MAX);
+    cfg.enter = (uint32_t)floor(ck.burst[0] * ck.period / 100.0);
+    cfg.delay = (uint32_t)ceil(ck.time[0] * ck.fs / 1e6);
+    cfg.mod = (uint32_t)floor(ck.burst[1] * ck.period / 100.0);
+    cfg.low = (int32_t)ceil(ck.thr[0] * (double)ctx.ref / 100.0);
+    cfg.high = -(int32_t)ceil(ck.thr[1] * (double)ctx.ref / 100.0);
+    cfg.exit = (int32_t)ceil(ck.thr[2] * (double)ctx.ref / 100.0);
+    cfg.maxLen = (uint32_t)ceil(ck.time[1] * ck.fs / 1e6);
+    cfg.gate = &gate;
+    if (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_burst_init(&burst, &cfg))
+    {
+        (void)printf("FAIL: the burst mode configuration\n");
+        return 2;
+    }
+    gateCalls = 0U; /* The outputs are ungated by the initialization */
+    gateBad = 0U;
+
+    /* The PI regulator: the peak current mode plant is the output capacitor integrating the current */
+    wc = 2.0 * PI * ck.bw;
+    kp = ck.k * wc * ck.c / ck.scale;
+    (void)memset(&regCfg, 0, sizeof(regCfg));
+    regCfg.b[0] = (float32_t)(kp * (1.0 + (wc / (5.0 * ck.fs))));
+    regCfg.b[1] = (float32_t)(-kp);
+    regCfg.a[1] = 1.0f;
+    regCfg.min = 0.0f;
+    regCfg.max = (float32_t)ck.period;
+    (void)mtb_pwrconv_2p2z_float_init(&reg, &regCfg);
+
+    /* The steady state at the heavy load */
+    plant_buck_init(&plant, ck.l, ck.c, ck.rl, ck.rc, ck.vin, 1.0 / ck.fs);
+    plant.iload = ck.load[0];
+    plant.il = ck.load[0];
+    plant.vc = ck.vout;
+    ctx.mod = (uint32_t)lround(ck.load[0] / ck.scale);
+    reg.dat.o[0] = (float32_t)ctx.mod;
+    reg.dat.o[1] = (float32_t)ctx.mod;
+
+    for (uint32_t k = 0U; k < (3U * ck.num); k++)
+    {
+        bool active = mtb_pwrconv_burst_is_active(&burst);
+
+        plant.iload = ((k >= ck.num) && (k < (2U * ck.num))) ? ck.load[1] : ck.load[0];
+        if (gateOn)
+        {
+            plant_buck_step_pccm(&plant, (double)ctx.mod * ck.scale);
+        }
+        else
+        {
+            plant_buck_step_vcm(&plant, 0.0, true); /* The inductor current decays through the body diode */
+        }
+        ctx.res = plant_adc(plant_buck_vout(&plant), ck.k, UINT32_MAX);
+        (void)mtb_pwrconv_get_error(&ctx);
+
+        /* The generated control loop ISR: the regulator runs when the burst mode returns false */
+        if (!mtb_pwrconv_burst_process(&burst, &ctx))
+        {
+            (void)mtb_pwrconv_2p2z_float_process(&reg, ctx.err, &ctx.mod);
+            if (active)
+            {
+                exit = (0U == exit) ? k : exit;
+                exitRun++;
+            }
+        }
+        else if (!active)
+        {
+            entry = (0U == entry) ? k : entry;
+        }
+        else
+        {
+            /* Within the burst mode */
+        }
+
+        if ((k >= ck.num) && (k < (2U * ck.num)) && (0U != entry))
+        {
+            spurious += mtb_pwrconv_burst_is_active(&burst) ? 0U : 1U;
+            if (k >= (ck.num + (ck.num / 2U)))
+            {
+                vMin = (plant_buck_vout(&plant) < vMin) ? plant_buck_vout(&plant) : vMin;
+                vMax = (plant_buck_vout(&plant) > vMax) ? plant_buck_vout(&plant) : vMax;
+            }
+        }
+        if ((k + 1U) == (2U * ck.num))
+        {
+            bursts = burst.dat.bursts;
+        }
+        if (k >= ((3U * ck.num) - (ck.num / 4U)))
+        {
+            errMax = (ctx.err > errMax) ? ctx.err : errMax;
+            errMin = (ctx.err < errMin) ? ctx.err : errMin;
+        }
+        if (NULL != ck.out)
+        {
+            (void)fprintf(ck.out, "%u,%g,%g,%d,%u,%u,%u\n", n, plant_buck_vout(&plant), plant.il, ctx.err, ctx.mod,
+                          mtb_pwrconv_burst_is_active(&burst) ? 1U : 0U, gateOn ? 1U : 0U);
+        }
+        n++;
+    }
+
+    if ((0U == entry) || (entry < ck.num) || (entry >= (2U * ck.num)))
+    {
+        (void)printf("FAIL: the burst mode is not entered at the light load\n");
+        rslt = 2;
+    }
+    else
+    {
+        (void)printf("light load %g A: entered after %g us, %u bursts, the output %g..%g V\n", ck.load[1],
+                     1e6 * (double)(entry - ck.num) / ck.fs, bursts, vMin, vMax);
+        if ((0U == bursts) || (0U != spurious))
+        {
+            (void)printf("FAIL: the burst mode is left %u periods at the light load\n", spurious);
+            rslt = 2;
+        }
+    }
+    if ((0U == exit) || (exit < (2U * ck.num)) || (1U != exitRun))
+    {
+        (void)printf("FAIL: the burst mode is not left once at the heavy load\n");
+        rslt = 2;
+    }
+    else
+    {
+        (void)printf("heavy load %g A: left after %g us, the final error %d..%d counts\n", ck.load[0],
+                     1e6 * (double)(exit - (2U * ck.num)) / ck.fs, errMin, errMax);
+    }
+    if (((double)errMax > ck.tol) || ((double)errMin < -ck.tol))
+    {
+        (void)printf("FAIL: the regulator does not settle within %g counts\n", ck.tol);
+        rslt = 2;
+    }
+    if ((0U != gateBad) || !gateOn)
+    {
+        (void)printf("FAIL: %u of %u gating calls do not change the outputs state\n", gateBad, gateCalls);
+        rslt = 2;
+    }
+    if (NULL != ck.out)
+    {
+        (void)fclose(ck.out);
+    }
+    if (EXIT_SUCCESS == rslt)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */
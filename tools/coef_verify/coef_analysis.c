@@ -0,0 +1,381 @@
+/***************************************************************************//**
+* \file coef_analysis.c
+* \version 1.0
+* \brief The host (PC) library analyzing the discrete regulator coefficients.
+*        See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "coef_analysis.h"
+
+#include <math.h>
+#include <string.h>
+
+#define COEF_ROOT_ITER      (500)
+#define COEF_UNIT_TOL       (1e-9)   /* The pole radius tolerance to be considered on the unit circle */
+#define COEF_INTEG_TOL      (1e-12)  /* The denominator sum tolerance to be considered the integrator,
+                                      * above the decimal coefficients rounding, below the float32 one */
+
+
+int coef_roots(double const * p, int deg, double complex * r)
+{
+    double complex c[COEF_ORDER_MAX + 1];
+    int n = deg;
+    int lead = 0;
+
+    while ((n > 0) && (0.0 == p[lead]))
+    {
+        lead++;
+        n--;
+    }
+
+    /* The monic polynomial */
+    for (int k = 0; k <= n; k++)
+    {
+        c[k] = p[lead + k] / p[lead];
+    }
+
+    /* Durand-Kerner iterations from the non-symmetric start points */
+    for (int k = 0; k < n; k++)
+    {
+        r[k] = cpow(0.4 + 0.9 * I, k);
+    }
+    for (int it = 0; it < COEF_ROOT_ITER; it++)
+    {
+        double delta = 0.0;
+
+        for (int k = 0; k < n; k++)
+        {
+            double complex v = c[0];
+            double complex d = 1.0;
+
+            for (int j = 1; j <= n; j++)
+            {
+                v = (v * r[k]) + c[j];
+            }
+            for (int j = 0; j < n; j++)
+            {
+                if (j != k)
+                {
+                    d *= r[k] - r[j];
+                }
+            }
+            if (0.0 != cabs(d))
+            {
+                v /= d;
+                r[k] -= v;
+                delta = fmax(delta, cabs(v));
+            }
+        }
+        if (delta < 1e-15)
+        {
+            break;
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        if (fabs(cimag(r[k])) < (1e-12 * (1.0 + cabs(r[k]))))
+        {
+            r[k] = creal(r[k]); /* The real root */
+        }
+    }
+
+    return n;
+}
+
+
+int coef_zeros(coef_reg_t const * reg, double complex * z)
+{
+    return coef_roots(reg->b, reg->order, z);
+}
+
+
+int coef_poles(coef_reg_t const * reg, double complex * p)
+{
+    double d[COEF_ORDER_MAX + 1];
+
+    d[0] = 1.0;
+    for (int k = 1; k <= reg->order; k++)
+    {
+        d[k] = -reg->a[k];
+    }
+
+    return coef_roots(d, reg->order, p);
+}
+
+
+coef_stab_t coef_stability(coef_reg_t const * reg, double * margin)
+{
+    double complex p[COEF_ORDER_MAX];
+    double sum = 0.0;
+    double rMax = 0.0;
+    int n = coef_poles(reg, p);
+    int unit = 0;
+    bool integ;
+    coef_stab_t stab;
+
+    /* The integrator is detected by the coefficients sum, not by the rounded root */
+    for (int k = 1; k <= reg->order; k++)
+    {
+        sum += reg->a[k];
+    }
+    integ = (fabs(1.0 - sum) < COEF_INTEG_TOL);
+
+    for (int k = 0; k < n; k++)
+    {
+        double rad = cabs(p[k]);
+
+        if (integ && (cabs(p[k] - 1.0) < 1e-6) && (0 == unit))
+        {
+            unit++; /* The integrator itself */
+        }
+        else
+        {
+            rMax = fmax(rMax, rad);
+        }
+    }
+
+    *margin = 1.0 - rMax;
+    if (rMax > (1.0 + COEF_UNIT_TOL))
+    {
+        stab = COEF_UNSTABLE;
+    }
+    else if (rMax > (1.0 - COEF_UNIT_TOL))
+    {
+        stab = COEF_MARGINAL;
+    }
+    else
+    {
+        stab = integ ? COEF_INTEGRATOR : COEF_STABLE;
+    }
+
+    return stab;
+}
+
+
+double coef_dc_gain(coef_reg_t const * reg)
+{
+    double num = 0.0;
+    double den = 1.0;
+
+    for (int k = 0; k <= reg->order; k++)
+    {
+        num += reg->b[k];
+        den -= (0 < k) ? reg->a[k] : 0.0;
+    }
+
+    return (fabs(den) < COEF_INTEG_TOL) ? HUGE_VAL : (num / den);
+}
+
+
+double complex coef_freq(coef_reg_t const * reg, double w)
+{
+    double complex num = 0.0;
+    double complex den = 1.0;
+
+    for (int k = 0; k <= reg->order; k++)
+    {
+        double complex zk = cexp(-I * w * (double)k); /* z^-k */
+
+        num += reg->b[k] * zk;
+        den -= (0 < k) ? (reg->a[k] * zk) : 0.0;
+    }
+
+    return num / den;
+}
+
+
+void coef_to_float32(coef_reg_t const * src, coef_reg_t * dst)
+{
+    *dst = *src;
+    for (int k = 0; k <= src->order; k++)
+    {
+        dst->a[k] = (double)(float)src->a[k];
+        dst->b[k] = (double)(float)src->b[k];
+    }
+}
+
+
+bool coef_to_fixed(coef_reg_t const * src, int frac, coef_reg_t * dst, int32_t * qa, int32_t * qb)
+{
+    double scale = ldexp(1.0, frac);
+    bool ok = true;
+
+    *dst = *src;
+    for (int k = 0; k <= src->order; k++)
+    {
+        double va = nearbyint(src->a[k] * scale);
+        double vb = nearbyint(src->b[k] * scale);
+
+        if ((fabs(va) > 2147483647.0) || (fabs(vb) > 2147483647.0))
+        {
+            ok = false;
+            va = 0.0;
+            vb = 0.0;
+        }
+        qa[k] = (int32_t)va;
+        qb[k] = (int32_t)vb;
+        dst->a[k] = va / scale;
+        dst->b[k] = vb / scale;
+    }
+
+    return ok;
+}
+
+
+void coef_sim_ref(coef_reg_t const * reg, int32_t const * e, uint32_t num, double min, double max,
+                  double bias, double * y)
+{
+    double i[COEF_ORDER_MAX + 1] = { 0.0 };
+    double o[COEF_ORDER_MAX + 1];
+
+    for (int k = 0; k <= COEF_ORDER_MAX; k++)
+    {
+        o[k] = bias;
+    }
+
+    for (uint32_t n = 0U; n < num; n++)
+    {
+        double acc;
+
+        for (int k = reg->order; k > 0; k--)
+        {
+            i[k] = i[k - 1];
+        }
+        i[0] = (double)e[n];
+
+        acc = 0.0;
+        for (int k = 0; k <= reg->order; k++)
+        {
+            acc += reg->b[k] * i[k];
+        }
+        for (int k = 1; k <= reg->order; k++)
+        {
+            acc += reg->a[k] * o[k - 1];
+        }
+        acc = fmin(fmax(acc, min), max);
+
+        for (int k = reg->order - 1; k > 0; k--)
+        {
+            o[k] = o[k - 1];
+        }
+        o[0] = acc;
+        y[n] = acc;
+    }
+}
+
+
+void coef_sim_fixed(coef_reg_t const * reg, int32_t const * qa, int32_t const * qb, int frac,
+                    int32_t const * e, uint32_t num, double min, double max, double bias,
+                    double const * y, coef_err_t * res)
+{
+    double scale = ldexp(1.0, frac);
+    int64_t qMin = (int64_t)floor(min * scale);
+    int64_t qMax = (int64_t)floor(max * scale);
+    int64_t i[COEF_ORDER_MAX + 1] = { 0 };
+    int64_t o[COEF_ORDER_MAX + 1];
+    double sum2 = 0.0;
+
+    (void)memset(res, 0, sizeof(*res));
+    for (int k = 0; k <= COEF_ORDER_MAX; k++)
+    {
+        o[k] = (int64_t)floor(bias * scale);
+    }
+
+    for (uint32_t n = 0U; n < num; n++)
+    {
+        int64_t acc = 0;
+        double d;
+
+        for (int k = reg->order; k > 0; k--)
+        {
+            i[k] = i[k - 1];
+        }
+        i[0] = e[n];
+
+        for (int k = 0; k <= reg->order; k++)
+        {
+            acc += (int64_t)qb[k] * i[k];
+        }
+        for (int k = 1; k <= reg->order; k++)
+        {
+            /* The arithmetic shift of the signed product, as the target Cortex-M code does */
+            acc += ((int64_t)qa[k] * o[k - 1]) >> frac;
+        }
+        acc = (acc < qMin) ? qMin : ((acc > qMax) ? qMax : acc);
+        if ((acc > INT32_MAX) || (acc < INT32_MIN))
+        {
+            res->overflow = true;
+        }
+
+        for (int k = reg->order - 1; k > 0; k--)
+        {
+            o[k] = o[k - 1];
+        }
+        o[0] = acc;
+
+        d = fabs(((double)acc / scale) - y[n]);
+        res->maxErr = fmax(res->maxErr, d);
+        sum2 += d * d;
+        if ((acc >> frac) != (int64_t)floor(y[n]))
+        {
+            res->modDiff++;
+        }
+    }
+    res->rmsErr = (0U != num) ? sqrt(sum2 / (double)num) : 0.0;
+}
+
+
+void coef_compare(double const * x, double const * y, uint32_t num, coef_err_t * res)
+{
+    double sum2 = 0.0;
+
+    (void)memset(res, 0, sizeof(*res));
+    for (uint32_t n = 0U; n < num; n++)
+    {
+        double d = fabs(x[n] - y[n]);
+
+        res->maxErr = fmax(res->maxErr, d);
+        sum2 += d * d;
+        if (floor(x[n]) != floor(y[n]))
+        {
+            res->modDiff++;
+        }
+    }
+    res->rmsErr = (0U != num) ? sqrt(sum2 / (double)num) : 0.0;
+}
+
+
+/* [] END OF FILE */
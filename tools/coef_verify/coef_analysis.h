@@ -0,0 +1,136 @@
+/***************************************************************************//**
+* \file coef_analysis.h
+* \version 1.0
+* \brief The host (PC) library analyzing the discrete regulator coefficients:
+*        the poles and zeros, stability, DC gain, frequency response and the quantization error.
+*        See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef COEF_ANALYSIS_H
+#define COEF_ANALYSIS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <complex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The maximal regulator order */
+#define COEF_ORDER_MAX      (3)
+
+/** The regulator coefficients in the mtb_stc_pwrconv_reg_XpXz_float_cfg_t layout:
+ * y[n] = b[0] e[n] + ... + b[N] e[n-N] + a[1] y[n-1] + ... + a[N] y[n-N], a[0] is unused
+ */
+typedef struct
+{
+    int    order;                    /* 2 for the 2P2Z, 3 for the 3P3Z */
+    double a[COEF_ORDER_MAX + 1];
+    double b[COEF_ORDER_MAX + 1];
+} coef_reg_t;
+
+/** The stability classes */
+typedef enum
+{
+    COEF_STABLE,                     /* All the poles are inside the unit circle */
+    COEF_INTEGRATOR,                 /* One pole is at z = 1, the others are inside */
+    COEF_MARGINAL,                   /* The poles on the unit circle other than the single integrator */
+    COEF_UNSTABLE                    /* A pole is outside the unit circle */
+} coef_stab_t;
+
+/** The time domain comparison result */
+typedef struct
+{
+    double   maxErr;                 /* The maximal output difference from the reference, counts */
+    double   rmsErr;                 /* The RMS output difference from the reference, counts */
+    uint32_t modDiff;                /* The number of the differing integer modulator values */
+    bool     overflow;               /* The fixed point state or coefficient doesn't fit into 32 bits */
+} coef_err_t;
+
+/** Calculates the roots of the polynomial p[0] x^deg + ... + p[deg], the leading zero coefficients
+ * reduce the degree. Returns the number of the roots.
+ */
+int coef_roots(double const * p, int deg, double complex * r);
+
+/** Calculates the regulator zeros, returns their number */
+int coef_zeros(coef_reg_t const * reg, double complex * z);
+
+/** Calculates the regulator poles, returns their number (the regulator order) */
+int coef_poles(coef_reg_t const * reg, double complex * p);
+
+/** Classifies the regulator stability, \p margin is set to 1 minus the maximal radius of the poles
+ * except the integrator one.
+ */
+coef_stab_t coef_stability(coef_reg_t const * reg, double * margin);
+
+/** Returns the DC gain, or HUGE_VAL for the regulator with the integrator */
+double coef_dc_gain(coef_reg_t const * reg);
+
+/** Returns the regulator frequency response at the normalized angular frequency w = 2 pi f / fs */
+double complex coef_freq(coef_reg_t const * reg, double w);
+
+/** Rounds the coefficients to float32 */
+void coef_to_float32(coef_reg_t const * src, coef_reg_t * dst);
+
+/** Rounds the coefficients to the signed 32-bit fixed point with \p frac fractional bits,
+ * \p q receives the integer coefficients. Returns false when a coefficient does not fit.
+ */
+bool coef_to_fixed(coef_reg_t const * src, int frac, coef_reg_t * dst, int32_t * qa, int32_t * qb);
+
+/** Runs the double precision reference regulator, the output is limited by \p min and \p max
+ * (the anti-windup) and starts from \p bias.
+ */
+void coef_sim_ref(coef_reg_t const * reg, int32_t const * e, uint32_t num, double min, double max,
+                  double bias, double * y);
+
+/** Runs the fixed point regulator: the integer coefficients with \p frac fractional bits,
+ * the 64-bit accumulator, the output history in the same format, truncated by the arithmetic shift,
+ * and compares its output with the reference \p y.
+ */
+void coef_sim_fixed(coef_reg_t const * reg, int32_t const * qa, int32_t const * qb, int frac,
+                    int32_t const * e, uint32_t num, double min, double max, double bias,
+                    double const * y, coef_err_t * res);
+
+/** Compares the implementation output \p x with the reference \p y */
+void coef_compare(double const * x, double const * y, uint32_t num, coef_err_t * res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COEF_ANALYSIS_H */
+
+/* [] END OF FILE */
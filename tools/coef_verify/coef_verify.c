@@ -0,0 +1,451 @@
+/***************************************************************************//**
+* \file coef_verify.c
+* \version 1.0
+* \brief The host (PC) tool verifying the regulator coefficients stability and quantization.
+*        See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_3p3z_float.h"
+#include "coef_analysis.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#define QFMT_MAX            (8)
+#define PI                  (3.14159265358979323846)
+
+/* The verification options */
+typedef struct
+{
+    coef_reg_t reg;                              /* The reference (double precision) coefficients */
+    double     k;                                /* The gain the numerator is multiplied by */
+    double     fs;                               /* The sampling frequency, Hz */
+    double     lim[2];                           /* The regulator output limits */
+    double     amp;                              /* The excitation amplitude, counts */
+    uint32_t   num;                              /* The number of the simulated samples */
+    int        points;                           /* The number of the frequency response points */
+    int        frac[QFMT_MAX];                   /* The fixed point candidates fractional bits */
+    int        numQ;
+    FILE     * out;                              /* The optional frequency response CSV output */
+} verify_t;
+
+static char const * const stabName[] = { "stable", "stable with the integrator", "MARGINAL", "UNSTABLE" };
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -r 2p2z|3p3z       the regulator type, 2p2z by default\n"
+        "  -b b0,b1,b2[,b3]   the regulator numerator coefficients (myPwrConv_B0..B3 or myPwrConv_regCfg.b)\n"
+        "  -a a1,a2[,a3]      the regulator denominator coefficients (myPwrConv_A1..A3)\n"
+        "  -k gain            the numerator gain (myPwrConv_K), 1 by default\n"
+        "  -f fs              the regulator sampling frequency, Hz, 1 (normalized) by default\n"
+        "  -l min,max         the regulator output limits (myPwrConv_regCfg.min/max), 0,65535 by default\n"
+        "  -q f1,f2,...       the fixed point candidates fractional bits, 16,20,24 by default\n"
+        "  -e amp             the error excitation amplitude, counts, 16 by default\n"
+        "  -n num             the number of the simulated samples, 100000 by default\n"
+        "  -p points          the number of the printed frequency response points, 12 by default\n"
+        "  -o file.csv        write the frequency response: f,ref dB,ref deg,float32 dB,float32 deg,Qx dB,Qx deg...\n",
+        name);
+}
+
+
+static void print_roots(char const * name, double complex const * r, int n)
+{
+    (void)printf("  %s:", name);
+    for (int k = 0; k < n; k++)
+    {
+        if (0.0 == cimag(r[k]))
+        {
+            (void)printf(" %.9g", creal(r[k]));
+        }
+        else
+        {
+            (void)printf(" %.9g%+.9gj (|%.9f|)", creal(r[k]), cimag(r[k]), cabs(r[k]));
+        }
+    }
+    (void)printf("%s\n", (0 == n) ? " none" : "");
+}
+
+
+/* Prints the coefficients analysis, returns the stability class */
+static coef_stab_t analyze(char const * title, coef_reg_t const * reg)
+{
+    double complex r[COEF_ORDER_MAX];
+    double margin;
+    double dc = coef_dc_gain(reg);
+    coef_stab_t stab = coef_stability(reg, &margin);
+    int n;
+
+    (void)printf("%s\n  b:", title);
+    for (int k = 0; k <= reg->order; k++)
+    {
+        (void)printf(" %.10g", reg->b[k]);
+    }
+    (void)printf("\n  a:");
+    for (int k = 1; k <= reg->order; k++)
+    {
+        (void)printf(" %.10g", reg->a[k]);
+    }
+    (void)printf("\n");
+    n = coef_zeros(reg, r);
+    print_roots("zeros", r, n);
+    n = coef_poles(reg, r);
+    print_roots("poles", r, n);
+    (void)printf("  stability: %s, margin (1 - max pole radius): %.3g\n", stabName[stab], margin);
+    if (isinf(dc))
+    {
+        (void)printf("  DC gain: infinite (integrator)\n");
+    }
+    else
+    {
+        (void)printf("  DC gain: %.6g (%.2f dB)\n", dc, 20.0 * log10(fabs(dc)));
+    }
+
+    return stab;
+}
+
+
+/* The maximal frequency response deviation from the reference over the dense grid */
+static void freq_dev(verify_t const * vf, coef_reg_t const * reg, double * dB, double * deg)
+{
+    *dB = 0.0;
+    *deg = 0.0;
+    for (int k = 0; k <= 1000; k++)
+    {
+        double w = PI * pow(10.0, -4.0 + (4.0 * (double)k / 1000.0));
+        double complex h0 = coef_freq(&vf->reg, w);
+        double complex h1 = coef_freq(reg, w);
+
+        *dB  = fmax(*dB, fabs(20.0 * log10(cabs(h1) / cabs(h0))));
+        *deg = fmax(*deg, fabs(carg(h1 / h0) * 180.0 / PI));
+    }
+}
+
+
+/* Runs the float32 regulator from the middleware, the outputs are the unrounded accumulator values */
+static void sim_float32(verify_t const * vf, int32_t const * e, double bias, double * x)
+{
+    uint32_t mod;
+
+    if (3 == vf->reg.order)
+    {
+        mtb_stc_pwrconv_reg_3p3z_float_ctx_t ctx;
+        mtb_stc_pwrconv_reg_3p3z_float_cfg_t cfg;
+
+        for (int k = 0; k < 4; k++)
+        {
+            cfg.a[k] = (float32_t)vf->reg.a[k];
+            cfg.b[k] = (float32_t)vf->reg.b[k];
+        }
+        cfg.min = (float32_t)vf->lim[0];
+        cfg.max = (float32_t)vf->lim[1];
+        (void)mtb_pwrconv_3p3z_float_init(&ctx, &cfg);
+        for (int k = 0; k < 3; k++)
+        {
+            ctx.dat.o[k] = (float32_t)bias;
+        }
+        for (uint32_t n = 0U; n < vf->num; n++)
+        {
+            (void)mtb_pwrconv_3p3z_float_process(&ctx, e[n], &mod);
+            x[n] = (double)ctx.dat.o[0];
+        }
+    }
+    else
+    {
+        mtb_stc_pwrconv_reg_2p2z_float_ctx_t ctx;
+        mtb_stc_pwrconv_reg_2p2z_float_cfg_t cfg;
+
+        for (int k = 0; k < 3; k++)
+        {
+            cfg.a[k] = (float32_t)vf->reg.a[k];
+            cfg.b[k] = (float32_t)vf->reg.b[k];
+        }
+        cfg.min = (float32_t)vf->lim[0];
+        cfg.max = (float32_t)vf->lim[1];
+        (void)mtb_pwrconv_2p2z_float_init(&ctx, &cfg);
+        for (int k = 0; k < 2; k++)
+        {
+            ctx.dat.o[k] = (float32_t)bias;
+        }
+        for (uint32_t n = 0U; n < vf->num; n++)
+        {
+            (void)mtb_pwrconv_2p2z_float_process(&ctx, e[n], &mod);
+            x[n] = (double)ctx.dat.o[0];
+        }
+    }
+}
+
+
+/* The deterministic zero-mean excitation: two tones and the dither */
+static void excitation(verify_t const * vf, int32_t * e)
+{
+    uint32_t seed = 12345U;
+
+    for (uint32_t n = 0U; n < vf->num; n++)
+    {
+        double v = vf->amp * ((0.6 * sin((2.0 * PI * (double)n) / 97.3)) + (0.4 * sin((2.0 * PI * (double)n) / 13.1)));
+
+        seed = (seed * 1664525U) + 1013904223U;
+        e[n] = (int32_t)lround(v) + (int32_t)(seed >> 30) - 1;
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    static verify_t vf;
+    double qList[QFMT_MAX];
+    double b[COEF_ORDER_MAX + 1];
+    double a[COEF_ORDER_MAX];
+    coef_reg_t f32;
+    coef_reg_t fix[QFMT_MAX];
+    int32_t qa[QFMT_MAX][COEF_ORDER_MAX + 1];
+    int32_t qb[QFMT_MAX][COEF_ORDER_MAX + 1];
+    bool fits[QFMT_MAX];
+    coef_stab_t refStab;
+    coef_stab_t stab;
+    coef_err_t err;
+    int32_t * e;
+    double * y;
+    double * x;
+    double bias;
+    double dB;
+    double deg;
+    int numA = 0;
+    int numB = 0;
+    int opt;
+    int rslt = EXIT_SUCCESS;
+
+    vf.reg.order = 2;
+    vf.k = 1.0;
+    vf.fs = 1.0;
+    vf.lim[0] = 0.0;
+    vf.lim[1] = 65535.0;
+    vf.amp = 16.0;
+    vf.num = 100000U;
+    vf.points = 12;
+    vf.numQ = 3;
+    vf.frac[0] = 16;
+    vf.frac[1] = 20;
+    vf.frac[2] = 24;
+    while (-1 != (opt = getopt(argc, argv, "r:b:a:k:f:l:q:e:n:p:o:")))
+    {
+        switch (opt)
+        {
+            case 'r': vf.reg.order = (0 == strcmp(optarg, "3p3z")) ? 3 : 2; break;
+            case 'b': numB = tool_parse_list(optarg, b, COEF_ORDER_MAX + 1); break;
+            case 'a': numA = tool_parse_list(optarg, a, COEF_ORDER_MAX); break;
+            case 'k': vf.k = strtod(optarg, NULL); break;
+            case 'f': vf.fs = strtod(optarg, NULL); break;
+            case 'l': (void)tool_parse_list(optarg, vf.lim, 2); break;
+            case 'q':
+                vf.numQ = tool_parse_list(optarg, qList, QFMT_MAX);
+                for (int k = 0; k < vf.numQ; k++)
+                {
+                    vf.frac[k] = (int)qList[k];
+                }
+                break;
+            case 'e': vf.amp = strtod(optarg, NULL); break;
+            case 'n': vf.num = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': vf.points = atoi(optarg); break;
+            case 'o':
+                vf.out = fopen(optarg, "w");
+                if (NULL == vf.out)
+                {
+                    (void)fprintf(stderr, "Can't write %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((numB != (vf.reg.order + 1)) || (numA != vf.reg.order) || (vf.numQ < 0) || (0U == vf.num) ||
+        (vf.fs <= 0.0) || (vf.lim[0] >= vf.lim[1]))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    vf.reg.a[0] = 0.0;
+    for (int k = 0; k <= vf.reg.order; k++)
+    {
+        vf.reg.b[k] = b[k] * vf.k;
+        vf.reg.a[k] = (0 < k) ? a[k - 1] : 0.0;
+    }
+
+    /* The coefficients analysis */
+    refStab = analyze("reference (double):", &vf.reg);
+    if (refStab >= COEF_MARGINAL)
+    {
+        rslt = 2;
+    }
+    coef_to_float32(&vf.reg, &f32);
+    stab = analyze("float32:", &f32);
+    if (stab > refStab)
+    {
+        rslt = 2;
+    }
+    for (int q = 0; q < vf.numQ; q++)
+    {
+        char title[64];
+
+        (void)snprintf(title, sizeof(title), "Q%d.%d (32-bit, %d fractional bits):",
+                       31 - vf.frac[q], vf.frac[q], vf.frac[q]);
+        fits[q] = coef_to_fixed(&vf.reg, vf.frac[q], &fix[q], qa[q], qb[q]);
+        if (fits[q])
+        {
+            stab = analyze(title, &fix[q]);
+            if (stab > refStab)
+            {
+                rslt = 2;
+            }
+        }
+        else
+        {
+            (void)printf("%s\n  the coefficients do not fit\n", title);
+        }
+    }
+
+    /* The frequency response */
+    (void)printf("\nfrequency response, |H| dB / phase deg:\n%12s %20s %20s", "f, Hz", "reference", "float32");
+    if (NULL != vf.out)
+    {
+        (void)fprintf(vf.out, "f,ref_db,ref_deg,f32_db,f32_deg");
+    }
+    for (int q = 0; q < vf.numQ; q++)
+    {
+        (void)printf("   %17s%d", "Q, frac ", vf.frac[q]);
+        if (NULL != vf.out)
+        {
+            (void)fprintf(vf.out, ",q%d_db,q%d_deg", vf.frac[q], vf.frac[q]);
+        }
+    }
+    (void)printf("\n");
+    if (NULL != vf.out)
+    {
+        (void)fprintf(vf.out, "\n");
+    }
+    for (int k = 0; k < vf.points; k++)
+    {
+        /* Logarithmic from fs / 10^4 to the Nyquist frequency */
+        double w = PI * pow(10.0, -4.0 + ((4.0 * (double)k) / (double)((vf.points > 1) ? (vf.points - 1) : 1)));
+        double complex h0 = coef_freq(&vf.reg, w);
+        double complex h1 = coef_freq(&f32, w);
+
+        (void)printf("%12.6g %10.3f %9.2f %10.3f %9.2f", (w * vf.fs) / (2.0 * PI),
+                     20.0 * log10(cabs(h0)), carg(h0) * 180.0 / PI, 20.0 * log10(cabs(h1)), carg(h1) * 180.0 / PI);
+        if (NULL != vf.out)
+        {
+            (void)fprintf(vf.out, "%.9g,%.6f,%.4f,%.6f,%.4f", (w * vf.fs) / (2.0 * PI),
+                          20.0 * log10(cabs(h0)), carg(h0) * 180.0 / PI, 20.0 * log10(cabs(h1)), carg(h1) * 180.0 / PI);
+        }
+        for (int q = 0; q < vf.numQ; q++)
+        {
+            double complex hq = coef_freq(&fix[q], w);
+
+            (void)printf(" %10.3f %9.2f", fits[q] ? 20.0 * log10(cabs(hq)) : NAN,
+                         fits[q] ? carg(hq) * 180.0 / PI : NAN);
+            if (NULL != vf.out)
+            {
+                (void)fprintf(vf.out, ",%.6f,%.4f", fits[q] ? 20.0 * log10(cabs(hq)) : NAN,
+                              fits[q] ? carg(hq) * 180.0 / PI : NAN);
+            }
+        }
+        (void)printf("\n");
+        if (NULL != vf.out)
+        {
+            (void)fprintf(vf.out, "\n");
+        }
+    }
+
+    /* The time domain error versus the double precision reference */
+    e = malloc(vf.num * sizeof(*e));
+    y = malloc(vf.num * sizeof(*y));
+    x = malloc(vf.num * sizeof(*x));
+    if ((NULL == e) || (NULL == y) || (NULL == x))
+    {
+        (void)fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    bias = floor((vf.lim[0] + vf.lim[1]) / 2.0);
+    excitation(&vf, e);
+    coef_sim_ref(&vf.reg, e, vf.num, vf.lim[0], vf.lim[1], bias, y);
+
+    (void)printf("\nerror versus the reference, %u samples, +/-%.0f counts excitation:\n", vf.num, vf.amp);
+    (void)printf("%-12s %16s %16s %14s %16s %16s\n", "format", "max err, counts", "rms err, counts",
+                 "mod differs", "max |H| dev, dB", "max phase dev");
+    sim_float32(&vf, e, bias, x);
+    coef_compare(x, y, vf.num, &err);
+    freq_dev(&vf, &f32, &dB, &deg);
+    (void)printf("%-12s %16.6g %16.6g %14u %16.3g %16.3g\n", "float32", err.maxErr, err.rmsErr, err.modDiff, dB, deg);
+    for (int q = 0; q < vf.numQ; q++)
+    {
+        char name[16];
+
+        (void)snprintf(name, sizeof(name), "Q%d.%d", 31 - vf.frac[q], vf.frac[q]);
+        if (!fits[q])
+        {
+            (void)printf("%-12s %16s\n", name, "coefficients overflow");
+            continue;
+        }
+        coef_sim_fixed(&fix[q], qa[q], qb[q], vf.frac[q], e, vf.num, vf.lim[0], vf.lim[1], bias, y, &err);
+        freq_dev(&vf, &fix[q], &dB, &deg);
+        (void)printf("%-12s %16.6g %16.6g %14u %16.3g %16.3g%s\n", name, err.maxErr, err.rmsErr, err.modDiff, dB, deg,
+                     err.overflow ? "  state exceeds 32 bits" : "");
+    }
+
+    free(e);
+    free(y);
+    free(x);
+    if (NULL != vf.out)
+    {
+        (void)fclose(vf.out);
+    }
+
+    return rslt;
+}
+
+
+/* [] END OF FILE */
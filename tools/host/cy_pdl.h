@@ -0,0 +1,63 @@
+/***************************************************************************//**
+* \file cy_pdl.h
+* \version 1.0
+* \brief The minimal host (PC) substitution of the PDL header for the Power Conversion host tools.
+*        Only the definitions used by the middleware headers are provided,
+*        it is not a part of the middleware and is not used by the target build.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_PDL_H
+#define CY_PDL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint32_t cy_rslt_t;
+typedef float float32_t;
+
+#define CY_RSLT_SUCCESS                     ((cy_rslt_t)0x00000000U)
+#define CY_RSLT_TYPE_ERROR                  (2U)
+#define CY_RSLT_MODULE_MIDDLEWARE_PWRCONV   (0x1D0U)
+#define CY_RSLT_CREATE(type, module, code)  ((((module) & 0x3FFFU) << 18U) | (((type) & 0x3U) << 16U) | \
+                                             ((code) & 0xFFFFU))
+
+#define __STATIC_INLINE                     static inline
+#define __STATIC_FORCEINLINE                static inline __attribute__((always_inline))
+#define __DMB()                             __sync_synchronize()
+
+#endif /* CY_PDL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,185 @@
+/***************************************************************************//**
+* \file hot_size.c
+* \version 1.0
+* \brief The host (PC) report of the control loop hot data size for the 'Hot data placement'.
+*        See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_3p3z_float.h"
+#include "mtb_pwrconv_pred_float.h"
+#include "mtb_pwrconv_obs_float.h"
+#include "mtb_pwrconv_burst.h"
+#include "mtb_pwrconv_trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* The regulators with the context in this tree */
+typedef struct
+{
+    char const * name;
+    size_t       size;
+} reg_t;
+
+static reg_t const regs[] =
+{
+    { "2p2z", sizeof(mtb_stc_pwrconv_reg_2p2z_float_ctx_t) },
+    { "3p3z", sizeof(mtb_stc_pwrconv_reg_3p3z_float_ctx_t) },
+    { "pred", sizeof(mtb_stc_pwrconv_reg_pred_float_ctx_t) },
+    { "none", 0U },
+};
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -r reg             the float regulator: 2p2z, 3p3z, pred or none for the custom control loop\n"
+        "  -O                 the load current observer\n"
+        "  -b                 the light-load burst mode\n"
+        "  -t                 the control loop trace\n"
+        "  -a bytes           the alignment, MTB_PWRCONV_HOT_ALIGN by default\n"
+        "  -n num             the number of the instances\n"
+        "  -s bytes           the section size to check the instances against\n", name);
+}
+
+
+/* Prints one placed variable, returns its footprint in the section */
+static size_t item(char const * name, size_t size, size_t align)
+{
+    size_t placed = ((size + align) - 1U) & ~(align - 1U);
+
+    (void)printf("  %-24s %6u %8u\n", name, (unsigned)size, (unsigned)placed);
+
+    return placed;
+}
+
+
+int main(int argc, char * argv[])
+{
+    reg_t const * reg = &regs[0];
+    bool obs = false;
+    bool burst = false;
+    bool trace = false;
+    size_t align = MTB_PWRCONV_HOT_ALIGN;
+    size_t total;
+    size_t hot = sizeof(mtb_stc_pwrconv_ctx_t); /* Only the fields used every period */
+    unsigned long num = 1UL;
+    unsigned long sect = 0UL;
+    int rslt = EXIT_SUCCESS;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "r:Obta:n:s:")))
+    {
+        switch (opt)
+        {
+            case 'r':
+                reg = NULL;
+                for (size_t idx = 0U; idx < (sizeof(regs) / sizeof(regs[0])); idx++)
+                {
+                    reg = (0 == strcmp(optarg, regs[idx].name)) ? &regs[idx] : reg;
+                }
+                if (NULL == reg)
+                {
+                    usage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'O': obs = true; break;
+            case 'b': burst = true; break;
+            case 't': trace = true; break;
+            case 'a': align = (size_t)strtoul(optarg, NULL, 0); break;
+            case 'n': num = strtoul(optarg, NULL, 0); break;
+            case 's': sect = strtoul(optarg, NULL, 0); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((0U == align) || (0U != (align & (align - 1U))) || (0UL == num))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    (void)printf("  %-24s %6s %8s\n", "variable", "size", "placed");
+    total = item("myPwrConv_ctx", sizeof(mtb_stc_pwrconv_ctx_t), align);
+    if (0U != reg->size)
+    {
+        total += item("myPwrConv_regCtx", reg->size, align);
+    }
+    if (obs)
+    {
+        total += item("myPwrConv_obsCtx", sizeof(mtb_stc_pwrconv_obs_float_ctx_t), align);
+    }
+    if (burst)
+    {
+        total += item("myPwrConv_burstCtx", sizeof(mtb_stc_pwrconv_burst_ctx_t), align);
+    }
+    if (trace)
+    {
+        total += item("myPwrConv_traceCtx", sizeof(mtb_stc_pwrconv_trace_ctx_t), align);
+    }
+    (void)printf("myPwrConv_HOT_SIZE: %u bytes\n", (unsigned)total);
+    (void)printf("the context (the fields used every period): %u bytes in the %u bytes block\n",
+                 (unsigned)hot, (unsigned)align);
+    if (hot > align)
+    {
+        (void)printf("FAIL: the context does not fit into one aligned block\n");
+        rslt = 2;
+    }
+    if (0UL != sect)
+    {
+        (void)printf("%lu instance(s): %lu of %lu bytes\n", num, num * (unsigned long)total, sect);
+        if ((num * (unsigned long)total) > sect)
+        {
+            (void)printf("FAIL: the instances do not fit into the section\n");
+            rslt = 2;
+        }
+    }
+    if (EXIT_SUCCESS == rslt)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,382 @@
+/***************************************************************************//**
+* \file mbox_stress.c
+* \version 1.0
+* \brief The host (PC) two-thread stress test of the parameter mailbox.
+*        See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* The ramp step posted with the target, so the torn update is detected */
+#define STEP_OF(targ)   (~(targ))
+
+/* The test state */
+typedef struct
+{
+    mtb_stc_pwrconv_t inst;
+    uint32_t posts;                              /* The number of the target posts */
+    uint32_t limEvery;                           /* The limits are posted every this number of the targets */
+    uint32_t stopEvery;                          /* The stop and run requests every this number of the targets */
+    uint32_t delay;                              /* The writer idle loop iterations between the posts */
+    uint32_t isr;                                /* The timer interrupt period, us, zero for the reader thread */
+    uint32_t prot;                               /* The protection stop period, us, zero for no protection */
+    volatile uint32_t done;                      /* The writer is finished */
+    uint32_t clk;                                /* The event order clock */
+    uint32_t startBeg;                           /* The clock before the last run request */
+    uint32_t startEnd;                           /* The clock after the last run request */
+    uint32_t stopBeg;                            /* The clock before the last protection stop request */
+    uint32_t stopEnd;                            /* The clock after the last protection stop request */
+    uint32_t stops;                              /* The number of the protection stop requests */
+    uint32_t prev;                               /* The previous target seen by the ramp */
+    uint32_t calls;                              /* The number of the ramp calls */
+    uint32_t fetched;                            /* The number of the changed targets seen by the ramp */
+    uint32_t torn;                               /* The number of the inconsistent updates */
+    uint32_t order;                              /* The number of the targets going back */
+    uint32_t state;                              /* The number of the inconsistent states */
+    uint32_t lost;                               /* The number of the lost stop requests */
+} stress_t;
+
+static stress_t stress;
+static mtb_stc_pwrconv_ctx_t stressCtx;
+static mtb_stc_pwrconv_cold_t stressCold;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -n posts           the number of the target posts, 10000000 by default\n"
+        "  -l posts           post the limits every this number of the targets, 7 by default\n"
+        "  -s posts           post the stop and run requests every this number of the targets, 1000 by default\n"
+        "  -d loops           the writer idle loop iterations between the posts, 100 by default,\n"
+        "                     zero keeps the mailbox always busy\n"
+        "  -i us              call the ramp from the timer signal with this period, preempting the writer\n"
+        "                     like the ramp timer ISR on the target, instead of the concurrent thread\n"
+        "  -p us              post the stop requests from the protection with this period, 50 by default,\n"
+        "                     zero for no protection: the thread, or the CPU time signal with -i\n", name);
+}
+
+
+/* The event order clock tick */
+static uint32_t tick(stress_t * st)
+{
+    return __atomic_add_fetch(&st->clk, 1U, __ATOMIC_SEQ_CST);
+}
+
+
+/* The protection context: disables the converter like mtb_pwrconv_disable() at any time */
+static void protect(stress_t * st)
+{
+    __atomic_store_n(&st->stopBeg, tick(st), __ATOMIC_SEQ_CST);
+    mtb_pwrconv_post_stop(st->inst.cold);
+    __atomic_store_n(&st->stopEnd, tick(st), __ATOMIC_SEQ_CST);
+    st->stops++;
+}
+
+
+/* The application context: posts the targets, limits and state requests */
+static void * writer(void * arg)
+{
+    stress_t * st = (stress_t *)arg;
+    mtb_stc_pwrconv_cold_t * cold = st->inst.cold;
+
+    for (uint32_t i = 1U; i <= st->posts; i++)
+    {
+        for (volatile uint32_t d = 0U; d < st->delay; d++)
+        {
+            /* The application work between the posts */
+        }
+        mtb_pwrconv_post(cold, i, STEP_OF(i));
+        if (0U == (i % st->limEvery))
+        {
+            mtb_pwrconv_post_limits(cold, 0U, UINT32_MAX);
+        }
+        if (0U == (i % st->stopEvery))
+        {
+            /* The disabling, the warm enabling and the start */
+            mtb_pwrconv_post_stop(cold);
+            mtb_pwrconv_post_state(cold, false, true, 0U);
+            __atomic_store_n(&st->startBeg, tick(st), __ATOMIC_SEQ_CST);
+            mtb_pwrconv_post_state(cold, true, false, 0U);
+            __atomic_store_n(&st->startEnd, tick(st), __ATOMIC_SEQ_CST);
+        }
+    }
+    __atomic_store_n(&st->done, 1U, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+
+/* The ramp context: fetches the mailbox and checks the working values */
+static void check(stress_t * st)
+{
+    mtb_stc_pwrconv_ctx_t const * ctx = st->inst.ctx;
+    mtb_stc_pwrconv_cold_t const * cold = st->inst.cold;
+    uint32_t stopEnd  = __atomic_load_n(&st->stopEnd, __ATOMIC_SEQ_CST);
+    uint32_t stopBeg  = __atomic_load_n(&st->stopBeg, __ATOMIC_SEQ_CST);
+    uint32_t startEnd = __atomic_load_n(&st->startEnd, __ATOMIC_SEQ_CST);
+    uint32_t startBeg = __atomic_load_n(&st->startBeg, __ATOMIC_SEQ_CST);
+    uint32_t run;
+
+    mtb_pwrconv_ramp(&st->inst);
+
+    /* The stop posted completely after the last run request and before this call is applied */
+    if ((stopBeg < stopEnd) && (startBeg < startEnd) && (startEnd < stopBeg) &&
+        (startBeg == __atomic_load_n(&st->startBeg, __ATOMIC_SEQ_CST)) &&
+        (0U != (ctx->state & MTB_PWRCONV_STATE_RUN)))
+    {
+        st->lost++;
+    }
+    st->calls++;
+    if (cold->rampStep != STEP_OF(cold->targ))
+    {
+        st->torn++;
+    }
+    if (cold->targ < st->prev)
+    {
+        st->order++;
+    }
+    if (cold->targ != st->prev)
+    {
+        st->fetched++;
+    }
+    st->prev = cold->targ;
+
+    /* The ramp step is larger than any target, so the running reference reaches the target at once */
+    run = ctx->state & MTB_PWRCONV_STATE_RUN;
+    if (((0U != run) && ((ctx->ref != cold->targ) || (0U != (ctx->state & MTB_PWRCONV_STATE_RAMP)))) ||
+        ((0U == run) && (0U != (ctx->state & MTB_PWRCONV_STATE_RAMP))))
+    {
+        st->state++;
+    }
+}
+
+
+static void on_timer(int sig)
+{
+    if (SIGALRM == sig)
+    {
+        check(&stress);
+    }
+    else
+    {
+        protect(&stress);
+    }
+}
+
+
+/* Runs the writer in the main thread, preempted by the timer signal */
+static int run_isr(stress_t * st)
+{
+    struct sigaction sa;
+    struct itimerval tmr;
+    struct itimerval prot;
+
+    (void)memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_timer;
+    (void)sigemptyset(&sa.sa_mask);
+    (void)memset(&tmr, 0, sizeof(tmr));
+    tmr.it_interval.tv_usec = (suseconds_t)st->isr;
+    tmr.it_value.tv_usec = (suseconds_t)st->isr;
+    (void)memset(&prot, 0, sizeof(prot));
+    prot.it_interval.tv_usec = (suseconds_t)st->prot;
+    prot.it_value.tv_usec = (suseconds_t)st->prot;
+
+    /* The protection signal preempts both the writer and the ramp, like the higher priority ISR */
+    if ((0 != sigaction(SIGALRM, &sa, NULL)) || (0 != sigaction(SIGPROF, &sa, NULL)) ||
+        (0 != setitimer(ITIMER_REAL, &tmr, NULL)) || (0 != setitimer(ITIMER_PROF, &prot, NULL)))
+    {
+        (void)fprintf(stderr, "Can't start the timer\n");
+        return EXIT_FAILURE;
+    }
+    (void)writer(st);
+    (void)memset(&tmr, 0, sizeof(tmr));
+    (void)setitimer(ITIMER_PROF, &tmr, NULL);
+    (void)setitimer(ITIMER_REAL, &tmr, NULL);
+
+    return EXIT_SUCCESS;
+}
+
+
+/* The protection thread: posts the stop requests until the writer is finished */
+static void * protection(void * arg)
+{
+    stress_t * st = (stress_t *)arg;
+    struct timespec ts = { 0, (long)st->prot * 1000L };
+
+    while (0U == __atomic_load_n(&st->done, __ATOMIC_ACQUIRE))
+    {
+        (void)nanosleep(&ts, NULL);
+        protect(st);
+    }
+
+    return NULL;
+}
+
+
+/* Runs the writer, the ramp and the protection in the concurrent threads */
+static int run_threads(stress_t * st)
+{
+    pthread_t thr;
+    pthread_t prot;
+
+    if (0 != pthread_create(&thr, NULL, writer, st))
+    {
+        (void)fprintf(stderr, "Can't create the writer thread\n");
+        return EXIT_FAILURE;
+    }
+    if ((0U != st->prot) && (0 != pthread_create(&prot, NULL, protection, st)))
+    {
+        (void)fprintf(stderr, "Can't create the protection thread\n");
+        return EXIT_FAILURE;
+    }
+    while (0U == __atomic_load_n(&st->done, __ATOMIC_ACQUIRE))
+    {
+        check(st);
+    }
+    (void)pthread_join(thr, NULL);
+    if (0U != st->prot)
+    {
+        (void)pthread_join(prot, NULL);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+
+int main(int argc, char * argv[])
+{
+    stress_t * st = &stress;
+    mtb_stc_pwrconv_ctx_t * ctx = &stressCtx;
+    mtb_stc_pwrconv_cold_t * cold = &stressCold;
+    int rslt;
+    int opt;
+
+    st->posts = 10000000U;
+    st->limEvery = 7U;
+    st->stopEvery = 1000U;
+    st->delay = 100U;
+    st->prot = 50U;
+    while (-1 != (opt = getopt(argc, argv, "n:l:s:d:i:p:")))
+    {
+        switch (opt)
+        {
+            case 'n': st->posts = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'l': st->limEvery = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': st->stopEvery = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': st->delay = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': st->isr = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': st->prot = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if ((0U == st->posts) || (0x7FFFFFFFU < st->posts) || (0U == st->limEvery) || (0U == st->stopEvery) ||
+        (999999U < st->isr) || (999999U < st->prot))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The custom mode instance: the target is the reference, the initialization like mtb_pwrconv_init() */
+    st->inst.targMax = UINT32_MAX;
+    st->inst.refMul = 1U;
+    st->inst.ctx = ctx;
+    st->inst.cold = cold;
+    st->inst.ramp = 1U;
+    mtb_pwrconv_post(cold, 0U, STEP_OF(0U));
+    mtb_pwrconv_post_limits(cold, 0U, UINT32_MAX);
+    mtb_pwrconv_post_state(cold, true, false, 0U);
+    (void)mtb_pwrconv_fetch(ctx, cold);
+
+    rslt = (0U != st->isr) ? run_isr(st) : run_threads(st);
+    if (EXIT_SUCCESS != rslt)
+    {
+        return rslt;
+    }
+    /* The restart after the last protection stop */
+    __atomic_store_n(&st->startBeg, tick(st), __ATOMIC_SEQ_CST);
+    mtb_pwrconv_post_state(cold, true, false, 0U);
+    __atomic_store_n(&st->startEnd, tick(st), __ATOMIC_SEQ_CST);
+    check(st); /* The last update */
+
+    (void)printf("%u posts, %u protection stops, %u ramp calls, %u targets fetched\n", st->posts, st->stops,
+                 st->calls, st->fetched);
+    if (0U != st->torn)
+    {
+        (void)printf("FAIL: %u torn updates\n", st->torn);
+        rslt = 2;
+    }
+    if (0U != st->order)
+    {
+        (void)printf("FAIL: %u targets fetched out of order\n", st->order);
+        rslt = 2;
+    }
+    if (0U != st->state)
+    {
+        (void)printf("FAIL: %u inconsistent states\n", st->state);
+        rslt = 2;
+    }
+    if (0U != st->lost)
+    {
+        (void)printf("FAIL: %u stop requests lost\n", st->lost);
+        rslt = 2;
+    }
+    if ((cold->targ != st->posts) || (0U == (ctx->state & MTB_PWRCONV_STATE_RUN)) ||
+        (cold->mbox.resAck != cold->mbox.reset) || (cold->mbox.stopAck != cold->mbox.stop))
+    {
+        (void)printf("FAIL: the last update is lost: target %u, state %u, reset %u/%u, stop %u/%u\n",
+                     cold->targ, ctx->state, cold->mbox.resAck, cold->mbox.reset, cold->mbox.stopAck, cold->mbox.stop);
+        rslt = 2;
+    }
+    if (EXIT_SUCCESS == rslt)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */
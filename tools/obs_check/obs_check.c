@@ -0,0 +1,378 @@
+/***************************************************************************//**
+* \file obs_check.c
+* \version 1.0
+* \brief The host (PC) check of the load current observer convergence against the power stage model.
+*        See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_obs_float.h"
+#include "plant_model.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#define PI                  (3.14159265358979323846)
+
+/* The check options */
+typedef struct
+{
+    bool   vcm;                                  /* The voltage mode, the peak current mode otherwise */
+    double l;                                    /* H */
+    double c;                                    /* F */
+    double rl;                                   /* Ohm */
+    double rc;                                   /* Ohm */
+    double vin;                                  /* V */
+    double fs;                                   /* The control loop sampling frequency, Hz */
+    double scale;                                /* VCM: the PWM period, counts; PCCM: amperes per count */
+    double k;                                    /* The feedback volts per count */
+    double freq;                                 /* The observer bandwidth, Hz */
+    double load[2];                              /* The load step, A */
+    double mis;                                  /* The plant L and C mismatch, % */
+    double tol;                                  /* The tolerated estimation error, % of the load step */
+    double gain[3];                              /* The observer gains */
+    bool   gainSet;                              /* The gains are given, calculated otherwise */
+    uint32_t num;                                /* The periods before and after the load step */
+    FILE * out;
+} check_t;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -m vcm|pccm        the control mode, vcm by default\n"
+        "  -L uH,-C uF        the total inductance and the output capacitance\n"
+        "  -r mOhm,-R mOhm    the inductor and the capacitor ESR\n"
+        "  -v V               the input voltage\n"
+        "  -f Hz              the control loop sampling frequency (SamplFreq)\n"
+        "  -s scale           VCM: the PWM period, counts; PCCM: the amperes per DAC count\n"
+        "  -k V               the feedback volts per ADC count\n"
+        "  -w Hz              the observer bandwidth\n"
+        "  -g l0,l1,l2        the generated gains (myPwrConv_obsCfg.l), calculated from -w otherwise\n"
+        "  -i i0,i1           the load step, A\n"
+        "  -e %%               the plant L and C mismatch versus the observer model\n"
+        "  -t %%               the tolerated load current estimation error, %% of the step\n"
+        "  -n periods         the periods before and after the load step\n"
+        "  -o file.csv        write the periods: n,iload,il,vout,res,est iload,est il\n", name);
+}
+
+
+static void mat3_mul(double const a[3][3], double const b[3][3], double r[3][3])
+{
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            r[i][j] = 0.0;
+            for (int k = 0; k < 3; k++)
+            {
+                r[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+}
+
+
+static void mat3_sub_diag(double const a[3][3], double value, double r[3][3])
+{
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            r[i][j] = a[i][j] - ((i == j) ? value : 0.0);
+        }
+    }
+}
+
+
+/* The observer model and gains, the same as calculated by the personality and the buck-1.0.tcl script */
+static void observer_cfg(check_t const * ck, mtb_stc_pwrconv_obs_float_cfg_t * cfg)
+{
+    double ts = 1.0 / ck->fs;
+    double pole = exp(-2.0 * PI * ck->freq * ts);
+    double a[3][3] = {{0.0, 0.0, 0.0}, {0.0, 1.0, -ts / ck->c}, {0.0, 0.0, 1.0}};
+    double l[3] = {0.0, 0.0, 0.0};
+    double b0;
+
+    if (ck->vcm)
+    {
+        a[0][0] = 1.0 - (ts * ck->rl / ck->l);
+        a[0][1] = -ts / ck->l;
+        a[1][0] = ts / ck->c;
+        b0 = ck->vin * ts / (ck->l * ck->scale);
+    }
+    else
+    {
+        b0 = ck->scale;
+    }
+
+    if (ck->gainSet)
+    {
+        (void)memcpy(l, ck->gain, sizeof(l));
+    }
+    else if (ck->vcm)
+    {
+        double slow = exp(-ts * ck->rl / ck->l);
+        double a2[3][3];
+        double a3[3][3];
+        double n[3][3];
+        double n2[3][3];
+        double s[3][3];
+        double phi[3][3];
+        double q[3];
+        double det;
+
+        mat3_mul(a, a, a2);
+        mat3_mul(a2, a, a3);
+
+        /* The last column of the inverse of the observability matrix rows C*A, C*A^2, C*A^3 */
+        det = (a[1][0] * ((a2[1][1] * a3[1][2]) - (a2[1][2] * a3[1][1]))) -
+              (a[1][1] * ((a2[1][0] * a3[1][2]) - (a2[1][2] * a3[1][0]))) +
+              (a[1][2] * ((a2[1][0] * a3[1][1]) - (a2[1][1] * a3[1][0])));
+        q[0] = ((a[1][1] * a2[1][2]) - (a[1][2] * a2[1][1])) / det;
+        q[1] = ((a[1][2] * a2[1][0]) - (a[1][0] * a2[1][2])) / det;
+        q[2] = ((a[1][0] * a2[1][1]) - (a[1][1] * a2[1][0])) / det;
+
+        /* Ackermann's formula with the characteristic polynomial (z - pole)^2 * (z - slow) */
+        mat3_sub_diag(a, pole, n);
+        mat3_mul(n, n, n2);
+        mat3_sub_diag(a, slow, s);
+        mat3_mul(n2, s, phi);
+        for (int i = 0; i < 3; i++)
+        {
+            l[i] = (phi[i][0] * q[0]) + (phi[i][1] * q[1]) + (phi[i][2] * q[2]);
+        }
+    }
+    else
+    {
+        l[1] = 1.0 - (pole * pole);
+        l[2] = -(1.0 - pole) * (1.0 - pole) * ck->c / ts;
+    }
+
+    (void)memset(cfg, 0, sizeof(*cfg));
+    for (int i = 0; i < 3; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            cfg->a[i][j] = (float32_t)a[i][j];
+        }
+        cfg->l[i] = (float32_t)l[i];
+    }
+    cfg->b[0] = (float32_t)b0;
+    cfg->b[1] = ck->vcm ? 0.0f : (float32_t)(b0 * ts / ck->c);
+    cfg->k = (float32_t)ck->k;
+    cfg->min = 0.0f;
+    cfg->max = 1.0e9f;
+}
+
+
+/* Runs the plant with the load step, returns the settling periods after the step
+ * or -1 when the estimation does not converge. The output voltage is kept by the slow regulator:
+ * the integral one in VCM (the crossover is fs / 1000, well below the LC resonance) and
+ * the proportional-integral one in PCCM (the crossover is fs / 100), so the load step is not compensated
+ * by the regulator during the observer settling.
+ */
+static long run(check_t const * ck, mtb_stc_pwrconv_obs_float_ctx_t * obs, double * maxErr)
+{
+    double ts = 1.0 / ck->fs;
+    double mis = 1.0 + (ck->mis / 100.0);
+    double vout = 0.5 * ck->vin;
+    double tol = fabs(ck->load[1] - ck->load[0]) * ck->tol / 100.0;
+    plant_buck_t plant;
+    double wc = 2.0 * PI * ck->fs / (ck->vcm ? 1000.0 : 100.0);
+    double kp = ck->vcm ? 0.0 : (wc * ck->c * ck->k / ck->scale);
+    double ki = ck->vcm ? (ck->scale * wc * ts * ck->k / ck->vin) : (kp * wc * ts / 4.0);
+    uint32_t ref = plant_adc(vout, ck->k, UINT32_MAX);
+    double acc;
+    uint32_t mod;
+    long settle = 0;
+
+    plant_buck_init(&plant, ck->l * mis, ck->c * mis, ck->rl, ck->rc, ck->vin, ts);
+
+    /* The steady state at the first load */
+    plant.iload = ck->load[0];
+    plant.il = ck->load[0];
+    plant.vc = vout;
+    mod = ck->vcm ? (uint32_t)lround((vout + (ck->rl * plant.il)) * ck->scale / ck->vin) :
+                    (uint32_t)lround(plant.il / ck->scale);
+    acc = (double)mod;
+
+    *maxErr = 0.0;
+    for (uint32_t n = 0U; n < (2U * ck->num); n++)
+    {
+        uint32_t res;
+        double err;
+
+        if (n == ck->num)
+        {
+            plant.iload = ck->load[1];
+        }
+        if (ck->vcm)
+        {
+            plant_buck_step_vcm(&plant, (double)mod / ck->scale, false);
+        }
+        else
+        {
+            plant_buck_step_pccm(&plant, (double)mod * ck->scale);
+        }
+        res = plant_adc(plant_buck_vout(&plant), ck->k, UINT32_MAX);
+
+        (void)mtb_pwrconv_obs_float_process(obs, res, mod);
+
+        err = fabs((double)mtb_pwrconv_obs_float_get_load(obs) - plant.iload);
+        if (n >= ck->num)
+        {
+            if (err > tol)
+            {
+                settle = (long)(n - ck->num) + 1L;
+            }
+            if (n >= ((2U * ck->num) - (ck->num / 4U)))
+            {
+                *maxErr = (err > *maxErr) ? err : *maxErr;
+            }
+        }
+        if (NULL != ck->out)
+        {
+            (void)fprintf(ck->out, "%u,%g,%g,%g,%u,%g,%g\n", n, plant.iload, plant.il, plant_buck_vout(&plant), res,
+                          (double)mtb_pwrconv_obs_float_get_load(obs), (double)mtb_pwrconv_obs_float_get_current(obs));
+        }
+
+        acc += ki * ((double)ref - (double)res);
+        acc = (acc > 0.0) ? acc : 0.0;
+        mod = (uint32_t)fmax(acc + (kp * ((double)ref - (double)res)), 0.0);
+    }
+
+    return (*maxErr > tol) ? -1L : settle;
+}
+
+
+int main(int argc, char * argv[])
+{
+    static check_t ck;
+    mtb_stc_pwrconv_obs_float_cfg_t cfg;
+    mtb_stc_pwrconv_obs_float_ctx_t obs;
+    double maxErr;
+    long settle;
+    int numG = 3;
+    int numI = 2;
+    int opt;
+
+    ck.vcm = true;
+    ck.l = 2.2e-6;
+    ck.c = 200e-6;
+    ck.rl = 10e-3;
+    ck.rc = 5e-3;
+    ck.vin = 12.0;
+    ck.fs = 250e3;
+    ck.scale = 1000.0;
+    ck.k = 1e-3;
+    ck.freq = 20e3;
+    ck.load[0] = 2.0;
+    ck.load[1] = 10.0;
+    ck.tol = 5.0;
+    ck.num = 5000U;
+    while (-1 != (opt = getopt(argc, argv, "m:L:C:r:R:v:f:s:k:w:g:i:e:t:n:o:")))
+    {
+        switch (opt)
+        {
+            case 'm':
+                ck.vcm = (0 != strcmp(optarg, "pccm"));
+                if (!ck.vcm && (1000.0 == ck.scale))
+                {
+                    ck.scale = 0.01;
+                }
+                break;
+            case 'L': ck.l = strtod(optarg, NULL) * 1e-6; break;
+            case 'C': ck.c = strtod(optarg, NULL) * 1e-6; break;
+            case 'r': ck.rl = strtod(optarg, NULL) * 1e-3; break;
+            case 'R': ck.rc = strtod(optarg, NULL) * 1e-3; break;
+            case 'v': ck.vin = strtod(optarg, NULL); break;
+            case 'f': ck.fs = strtod(optarg, NULL); break;
+            case 's': ck.scale = strtod(optarg, NULL); break;
+            case 'k': ck.k = strtod(optarg, NULL); break;
+            case 'w': ck.freq = strtod(optarg, NULL); break;
+            case 'g': numG = tool_parse_list(optarg, ck.gain, 3); ck.gainSet = true; break;
+            case 'i': numI = tool_parse_list(optarg, ck.load, 2); break;
+            case 'e': ck.mis = strtod(optarg, NULL); break;
+            case 't': ck.tol = strtod(optarg, NULL); break;
+            case 'n': ck.num = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o':
+                ck.out = fopen(optarg, "w");
+                if (NULL == ck.out)
+                {
+                    (void)fprintf(stderr, "Can't write %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((3 != numG) || (2 != numI) || (ck.l <= 0.0) || (ck.c <= 0.0) || (ck.rl <= 0.0) || (ck.vin <= 0.0) ||
+        (ck.fs <= 0.0) || (ck.scale <= 0.0) || (ck.k <= 0.0) || (ck.freq <= 0.0) || (ck.num < 4U))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    observer_cfg(&ck, &cfg);
+    (void)mtb_pwrconv_obs_float_init(&obs, &cfg);
+    (void)printf("gains: %g, %g, %g\n", (double)cfg.l[0], (double)cfg.l[1], (double)cfg.l[2]);
+
+    settle = run(&ck, &obs, &maxErr);
+    (void)printf("load step %g -> %g A, plant mismatch %g %%: the final estimation error %g A\n",
+                 ck.load[0], ck.load[1], ck.mis, maxErr);
+    if (NULL != ck.out)
+    {
+        (void)fclose(ck.out);
+    }
+    if (0L > settle)
+    {
+        (void)printf("FAIL: the load current estimation does not converge within %g %%\n", ck.tol);
+        return 2;
+    }
+    (void)printf("PASS: converged within %g %% in %ld periods (%g us)\n", ck.tol, settle, 1e6 * (double)settle / ck.fs);
+
+    return EXIT_SUCCESS;
+}
+
+/* [] END OF FILE */
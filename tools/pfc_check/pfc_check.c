@@ -0,0 +1,369 @@
+/***************************************************************************//**
+* \file pfc_check.c
+* \version 1.0
+* \brief The host (PC) check of the cascaded control loops and the PFC line synchronization
+*        against the boost PFC power stage model. See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_cascade.h"
+#include "mtb_pwrconv_pfc_float.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "plant_model.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#define PI                  (3.14159265358979323846)
+#define ADC_MAX             (4095U)
+
+/* The check options */
+typedef struct
+{
+    double   l;                                  /* H */
+    double   c;                                  /* F */
+    double   rl;                                 /* Ohm */
+    double   vnom;                               /* The nominal line RMS voltage, V */
+    double   vrms;                               /* The line RMS voltage, V */
+    double   vbus;                               /* The DC-bus voltage, V */
+    double   fline;                              /* The line frequency, Hz */
+    double   fs;                                 /* The inner loop sampling frequency, Hz */
+    double   period;                             /* The PWM period, counts */
+    double   kv;                                 /* The voltage feedback volts per count */
+    double   ki;                                 /* The current feedback amperes per count */
+    uint32_t div;                                /* The outer loop decimation factor */
+    double   bw[2];                              /* The inner and outer loop crossover frequencies, Hz */
+    double   load[2];                            /* The load power step, W */
+    double   time;                               /* The settling time before and after the load step, s */
+    double   tol;                                /* The tolerated DC-bus voltage error, % */
+    double   pf;                                 /* The minimal power factor */
+    FILE   * out;
+} check_t;
+
+/* The line cycles statistics */
+typedef struct
+{
+    double   p;                                  /* The input power sum */
+    double   v2;                                 /* The input voltage square sum */
+    double   i2;                                 /* The input current square sum */
+    double   vbus;                               /* The DC-bus voltage sum */
+    uint32_t n;
+} stat_t;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -L uH,-C uF        the boost inductance and the DC-bus capacitance\n"
+        "  -r mOhm            the inductor ESR\n"
+        "  -v Vrms,Vbus       the line RMS and the DC-bus voltages\n"
+        "  -n Vrms            the nominal line RMS voltage of the feedforward, 230 by default\n"
+        "  -F Hz              the line frequency\n"
+        "  -f Hz              the inner (current) loop sampling frequency\n"
+        "  -p counts          the PWM period\n"
+        "  -k V,A             the voltage and current feedback per ADC count\n"
+        "  -d div             the outer (voltage) loop decimation factor, the line half-cycle by default\n"
+        "  -w Hz,Hz           the inner and outer loop crossover frequencies\n"
+        "  -P W,W             the load power step\n"
+        "  -s s               the settling time before and after the load step, at least two line cycles\n"
+        "  -t %%               the tolerated DC-bus voltage error\n"
+        "  -m pf              the minimal power factor\n"
+        "  -o file.csv        write the periods: n,vin,iin,vbus,amp,ref,mod\n", name);
+}
+
+
+/* The PI regulator in the 2P2Z form by the backward Euler integration */
+static void reg_pi(mtb_stc_pwrconv_reg_2p2z_float_ctx_t * reg, double kp, double ki, double ts, double max)
+{
+    mtb_stc_pwrconv_reg_2p2z_float_cfg_t cfg;
+
+    (void)memset(&cfg, 0, sizeof(cfg));
+    cfg.b[0] = (float32_t)(kp + (ki * ts));
+    cfg.b[1] = (float32_t)(-kp);
+    cfg.a[1] = 1.0f;
+    cfg.min = 0.0f;
+    cfg.max = (float32_t)max;
+    (void)mtb_pwrconv_2p2z_float_init(reg, &cfg);
+}
+
+
+/* Reports the statistics of the whole line cycles and checks them, returns true when failed */
+static bool report(check_t const * ck, stat_t const * st, char const * name)
+{
+    double vin = sqrt(st->v2 / (double)st->n);
+    double iin = sqrt(st->i2 / (double)st->n);
+    double pin = st->p / (double)st->n;
+    double pf = pin / (vin * iin);
+    double vbus = st->vbus / (double)st->n;
+    double err = 100.0 * (vbus - ck->vbus) / ck->vbus;
+    bool fail = false;
+
+    (void)printf("%s: input %g W, PF %.4f, DC-bus %g V (%+.2f %%)\n", name, pin, pf, vbus, err);
+    if (fabs(err) > ck->tol)
+    {
+        (void)printf("FAIL: the DC-bus voltage error is above %g %%\n", ck->tol);
+        fail = true;
+    }
+    if (pf < ck->pf)
+    {
+        (void)printf("FAIL: the power factor is below %g\n", ck->pf);
+        fail = true;
+    }
+
+    return fail;
+}
+
+
+int main(int argc, char * argv[])
+{
+    static check_t ck;
+    static mtb_stc_pwrconv_cascade_t casc;
+    static mtb_stc_pwrconv_pfc_float_ctx_t pfc;
+    static mtb_stc_pwrconv_reg_2p2z_float_ctx_t volt;
+    static mtb_stc_pwrconv_reg_2p2z_float_ctx_t curr;
+    mtb_stc_pwrconv_pfc_float_cfg_t cfg;
+    plant_boost_t plant;
+    stat_t st;
+    double list[2];
+    double vpk;
+    double wc;
+    double kp;
+    uint32_t mod = 0UL;
+    uint32_t sum = 0UL;
+    uint32_t num;
+    uint32_t win;
+    uint32_t n = 0U;
+    uint32_t bad = 0U;
+    int rslt = EXIT_SUCCESS;
+    int opt;
+
+    ck.l = 1e-3;
+    ck.c = 470e-6;
+    ck.rl = 0.1;
+    ck.vnom = 230.0;
+    ck.vrms = 230.0;
+    ck.vbus = 400.0;
+    ck.fline = 50.0;
+    ck.fs = 100e3;
+    ck.period = 1000.0;
+    ck.kv = 0.12;
+    ck.ki = 0.002;
+    ck.div = 0U;
+    ck.bw[0] = 10000.0;
+    ck.bw[1] = 10.0;
+    ck.load[0] = 300.0;
+    ck.load[1] = 600.0;
+    ck.time = 0.5;
+    ck.tol = 1.0;
+    ck.pf = 0.98;
+    while (-1 != (opt = getopt(argc, argv, "L:C:r:v:n:F:f:p:k:d:w:P:s:t:m:o:")))
+    {
+        switch (opt)
+        {
+            case 'L': ck.l = strtod(optarg, NULL) * 1e-6; break;
+            case 'C': ck.c = strtod(optarg, NULL) * 1e-6; break;
+            case 'r': ck.rl = strtod(optarg, NULL) * 1e-3; break;
+            case 'v':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.vrms = list[0];
+                    ck.vbus = list[1];
+                }
+                break;
+            case 'n': ck.vnom = strtod(optarg, NULL); break;
+            case 'F': ck.fline = strtod(optarg, NULL); break;
+            case 'f': ck.fs = strtod(optarg, NULL); break;
+            case 'p': ck.period = strtod(optarg, NULL); break;
+            case 'k':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.kv = list[0];
+                    ck.ki = list[1];
+                }
+                break;
+            case 'd': ck.div = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'w': (void)tool_parse_list(optarg, ck.bw, 2); break;
+            case 'P': (void)tool_parse_list(optarg, ck.load, 2); break;
+            case 's': ck.time = strtod(optarg, NULL); break;
+            case 't': ck.tol = strtod(optarg, NULL); break;
+            case 'm': ck.pf = strtod(optarg, NULL); break;
+            case 'o':
+                ck.out = fopen(optarg, "w");
+                if (NULL == ck.out)
+                {
+                    (void)fprintf(stderr, "Can't write %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    vpk = ck.vrms * sqrt(2.0);
+    if ((ck.l <= 0.0) || (ck.c <= 0.0) || (ck.vnom <= 0.0) || (ck.vbus <= vpk) || (ck.fline <= 0.0) ||
+        (ck.fs <= (20.0 * ck.fline)) || (ck.period <= 0.0) || (ck.kv <= 0.0) || (ck.ki <= 0.0) ||
+        (ck.bw[0] <= 0.0) || (ck.bw[1] <= 0.0) || (ck.load[0] <= 0.0) || (ck.load[1] <= 0.0) ||
+        ((ck.time * ck.fline) < 2.0))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (0U == ck.div)
+    {
+        ck.div = (uint32_t)lround(ck.fs / (2.0 * ck.fline));
+    }
+    if (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_cascade_init(&casc, ck.div))
+    {
+        (void)printf("FAIL: the decimation factor %u is out of range\n", ck.div);
+        return 2;
+    }
+
+    /* The line synchronization: the reference peak equals the amplitude at the nominal line voltage */
+    cfg.k = (float32_t)(ck.vnom / (sqrt(2.0) * ck.kv));
+    cfg.zcHigh = (uint32_t)lround(0.1 * ck.vnom * sqrt(2.0) / ck.kv);
+    cfg.zcLow = cfg.zcHigh / 2UL;
+    cfg.msMin = (float32_t)pow(0.5 * ck.vnom / ck.kv, 2.0);
+    cfg.nMin = (uint32_t)(ck.fs / (2.0 * 1.3 * ck.fline));
+    cfg.nMax = (uint32_t)(ck.fs / (2.0 * 0.7 * ck.fline));
+    cfg.max = ADC_MAX;
+    if (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_pfc_float_init(&pfc, &cfg))
+    {
+        (void)printf("FAIL: the line synchronization configuration\n");
+        return 2;
+    }
+
+    /* The inner loop: the inductor current integrates the duty cycle by vbus / L,
+     * the outer loop: the DC-bus capacitor integrates the input power amp * ki * vpk / 2 at the nominal line
+     */
+    wc = 2.0 * PI * ck.bw[0];
+    kp = ck.l * ck.period * ck.ki * wc / ck.vbus;
+    reg_pi(&curr, kp, kp * wc / 5.0, 1.0 / ck.fs, 0.95 * ck.period);
+    wc = 2.0 * PI * ck.bw[1];
+    kp = 2.0 * ck.c * ck.vbus * ck.kv * wc / (ck.vnom * sqrt(2.0) * ck.ki);
+    reg_pi(&volt, kp, kp * wc / 2.0, (double)ck.div / ck.fs, (double)ADC_MAX);
+    casc.outer.ref = plant_adc(ck.vbus, ck.kv, ADC_MAX);
+
+    /* The DC-bus is pre-charged to the line peak by the inrush limiter */
+    plant_boost_init(&plant, ck.l, ck.c, ck.rl, 1.0 / ck.fs);
+    plant.vc = vpk;
+    plant.rload = ck.vbus * ck.vbus / ck.load[0];
+
+    num = (uint32_t)lround(ck.time * ck.fs);
+    win = (uint32_t)lround(ck.fs / ck.fline);
+    win *= (num / win) / 2U; /* The last half of the settling time */
+    (void)memset(&st, 0, sizeof(st));
+    for (uint32_t k = 0U; k < (2U * num); k++)
+    {
+        uint32_t vin;
+        uint32_t vbus;
+
+        plant.vin = vpk * fabs(sin(2.0 * PI * ck.fline * (double)n / ck.fs));
+        plant_boost_step(&plant, (double)mod / ck.period);
+        vin = plant_adc(plant.vin, ck.kv, ADC_MAX);
+        vbus = plant_adc(plant.vc, ck.kv, ADC_MAX);
+
+        /* The custom control loop callback as in the mtb_pwrconv.h cascade example */
+        (void)mtb_pwrconv_pfc_float_line(&pfc, vin);
+        sum += vbus;
+        if (mtb_pwrconv_cascade_outer(&casc, vbus))
+        {
+            if (casc.outer.res != (sum / ck.div))
+            {
+                bad++;
+            }
+            sum = 0UL;
+            (void)mtb_pwrconv_2p2z_float_process(&volt, casc.outer.err, &casc.outer.mod);
+        }
+        (void)mtb_pwrconv_cascade_inner(&casc, mtb_pwrconv_pfc_float_ref(&pfc, casc.outer.mod, vin),
+                                        plant_adc(plant.il, ck.ki, ADC_MAX));
+        (void)mtb_pwrconv_2p2z_float_process(&curr, casc.inner.err, &mod);
+
+        if (NULL != ck.out)
+        {
+            (void)fprintf(ck.out, "%u,%g,%g,%g,%u,%u,%u\n", n, plant.vin, plant.il, plant.vc,
+                          casc.outer.mod, casc.inner.ref, mod);
+        }
+        n++;
+
+        /* The statistics over the whole line cycles at the end of the settling time */
+        if ((k % num) >= (num - win))
+        {
+            st.p += plant.vin * plant.il;
+            st.v2 += plant.vin * plant.vin;
+            st.i2 += plant.il * plant.il;
+            st.vbus += plant.vc;
+            st.n++;
+        }
+        if ((k + 1U) == num)
+        {
+            rslt = report(&ck, &st, "before the load step") ? 2 : rslt;
+            (void)memset(&st, 0, sizeof(st));
+            plant.rload = ck.vbus * ck.vbus / ck.load[1];
+        }
+    }
+    rslt = report(&ck, &st, "after the load step") ? 2 : rslt;
+    (void)printf("line: %s, RMS %g V, %u half-cycles\n",
+                 mtb_pwrconv_pfc_float_line_ok(&pfc) ? "valid" : "invalid",
+                 (double)mtb_pwrconv_pfc_float_get_rms(&pfc) * ck.kv, pfc.dat.cnt);
+    if (!mtb_pwrconv_pfc_float_line_ok(&pfc))
+    {
+        (void)printf("FAIL: the line is not detected as valid\n");
+        rslt = 2;
+    }
+    if (0U != bad)
+    {
+        (void)printf("FAIL: %u outer loop averages differ from the division\n", bad);
+        rslt = 2;
+    }
+    if (NULL != ck.out)
+    {
+        (void)fclose(ck.out);
+    }
+    if (EXIT_SUCCESS == rslt)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,156 @@
+/***************************************************************************//**
+* \file plant_model.c
+* \version 1.0
+* \brief The host (PC) averaged power stage models for the middleware host checks.
+*        See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "plant_model.h"
+
+#include <math.h>
+
+#define PLANT_STEPS         (100U)
+
+
+void plant_buck_init(plant_buck_t * p, double l, double c, double rl, double rc, double vin, double ts)
+{
+    p->l = l;
+    p->c = c;
+    p->rl = rl;
+    p->rc = rc;
+    p->vin = vin;
+    p->ts = ts;
+    p->steps = PLANT_STEPS;
+    p->iload = 0.0;
+    p->rload = 0.0;
+    p->il = 0.0;
+    p->vc = 0.0;
+}
+
+
+double plant_buck_iout(plant_buck_t const * p)
+{
+    double iout = p->iload;
+
+    if (0.0 < p->rload)
+    {
+        /* vout = vc + rc * (il - iout), iout = iload + vout / rload */
+        iout = (p->iload + ((p->vc + (p->rc * p->il)) / p->rload)) / (1.0 + (p->rc / p->rload));
+    }
+
+    return iout;
+}
+
+
+double plant_buck_vout(plant_buck_t const * p)
+{
+    return p->vc + (p->rc * (p->il - plant_buck_iout(p)));
+}
+
+
+void plant_buck_step_vcm(plant_buck_t * p, double duty, bool gated)
+{
+    double h = p->ts / (double)p->steps;
+
+    for (uint32_t k = 0U; k < p->steps; k++)
+    {
+        double vout = plant_buck_vout(p);
+        double vsw = duty * p->vin;
+        double il;
+
+        if (gated)
+        {
+            /* The body diodes conduct until the current decays to zero, then the switch node floats */
+            vsw = (0.0 < p->il) ? 0.0 : p->vin;
+        }
+        il = p->il + ((h / p->l) * (vsw - vout - (p->rl * p->il)));
+
+        p->il = (gated && ((il * p->il) <= 0.0)) ? 0.0 : il;
+        p->vc += (h / p->c) * (p->il - plant_buck_iout(p));
+    }
+}
+
+
+void plant_buck_step_pccm(plant_buck_t * p, double iavg)
+{
+    double h = p->ts / (double)p->steps;
+
+    p->il = iavg;
+    for (uint32_t k = 0U; k < p->steps; k++)
+    {
+        p->vc += (h / p->c) * (p->il - plant_buck_iout(p));
+    }
+}
+
+
+void plant_boost_init(plant_boost_t * p, double l, double c, double rl, double ts)
+{
+    p->l = l;
+    p->c = c;
+    p->rl = rl;
+    p->vin = 0.0;
+    p->ts = ts;
+    p->steps = PLANT_STEPS;
+    p->rload = 0.0;
+    p->il = 0.0;
+    p->vc = 0.0;
+}
+
+
+void plant_boost_step(plant_boost_t * p, double duty)
+{
+    double h = p->ts / (double)p->steps;
+
+    for (uint32_t k = 0U; k < p->steps; k++)
+    {
+        double iout = (0.0 < p->rload) ? (p->vc / p->rload) : 0.0;
+        double il = p->il + ((h / p->l) * (p->vin - ((1.0 - duty) * p->vc) - (p->rl * p->il)));
+
+        p->il = (0.0 < il) ? il : 0.0;
+        p->vc += (h / p->c) * (((1.0 - duty) * p->il) - iout);
+    }
+}
+
+
+uint32_t plant_adc(double v, double k, uint32_t max)
+{
+    double cnt = floor((v / k) + 0.5);
+
+    cnt = (cnt > 0.0) ? cnt : 0.0;
+
+    return (cnt < (double)max) ? (uint32_t)cnt : max;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+* \file plant_model.h
+* \version 1.0
+* \brief The host (PC) averaged power stage models for the middleware host checks.
+*        See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PLANT_MODEL_H
+#define PLANT_MODEL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The averaged synchronous buck power stage: the inductor with its ESR, the output capacitor with its ESR,
+ * the constant current and the resistive load. The model is integrated by the sub-steps within one
+ * control loop sampling period, so it is independent of the discrete models under the check.
+ */
+typedef struct
+{
+    double   l;                      /* The inductance (total of all phases), H */
+    double   c;                      /* The output capacitance, F */
+    double   rl;                     /* The inductor ESR, Ohm */
+    double   rc;                     /* The capacitor ESR, Ohm */
+    double   vin;                    /* The input voltage, V */
+    double   ts;                     /* The sampling period, s */
+    uint32_t steps;                  /* The integration sub-steps per sampling period */
+    double   iload;                  /* The constant current load, A */
+    double   rload;                  /* The resistive load, Ohm, zero for none */
+    double   il;                     /* The inductor current state, A */
+    double   vc;                     /* The capacitor voltage state, V */
+} plant_buck_t;
+
+/** Initializes the buck model with the default 100 integration sub-steps in the discharged state */
+void plant_buck_init(plant_buck_t * p, double l, double c, double rl, double rc, double vin, double ts);
+
+/** Returns the output current, A */
+double plant_buck_iout(plant_buck_t const * p);
+
+/** Returns the output voltage, V */
+double plant_buck_vout(plant_buck_t const * p);
+
+/** Integrates the voltage mode model over one sampling period: \p duty is the averaged switch node duty
+ * cycle, 0..1. When \p gated, both switches are off and the inductor current flows through the body diode
+ * only, so it can't become negative (the discontinuous conduction).
+ */
+void plant_buck_step_vcm(plant_buck_t * p, double duty, bool gated);
+
+/** Integrates the peak current mode model over one sampling period: the inner current loop is assumed ideal,
+ * the averaged inductor current is set to \p iavg.
+ */
+void plant_buck_step_pccm(plant_buck_t * p, double iavg);
+
+/** The averaged boost (PFC) power stage: the inductor with its ESR, the boost diode and the output (DC-bus)
+ * capacitor with the resistive load. The input voltage is set by the caller every sampling period,
+ * e.g. the rectified line voltage.
+ */
+typedef struct
+{
+    double   l;                      /* The inductance, H */
+    double   c;                      /* The output capacitance, F */
+    double   rl;                     /* The inductor ESR, Ohm */
+    double   vin;                    /* The (rectified) input voltage, V */
+    double   ts;                     /* The sampling period, s */
+    uint32_t steps;                  /* The integration sub-steps per sampling period */
+    double   rload;                  /* The resistive load, Ohm, zero for none */
+    double   il;                     /* The inductor current state, A */
+    double   vc;                     /* The capacitor voltage state, V */
+} plant_boost_t;
+
+/** Initializes the boost model with the default 100 integration sub-steps in the discharged state */
+void plant_boost_init(plant_boost_t * p, double l, double c, double rl, double ts);
+
+/** Integrates the boost model over one sampling period: \p duty is the averaged switch duty cycle, 0..1.
+ * The diode blocks the negative inductor current (the discontinuous conduction).
+ */
+void plant_boost_step(plant_boost_t * p, double duty);
+
+/** Quantizes the voltage by the ADC with \p k volts per count and \p max full scale counts */
+uint32_t plant_adc(double v, double k, uint32_t max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLANT_MODEL_H */
+
+/* [] END OF FILE */
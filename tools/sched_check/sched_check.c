@@ -0,0 +1,362 @@
+/***************************************************************************//**
+* \file sched_check.c
+* \version 1.0
+* \brief The control loop ISR scheduler check: compares mtb_pwrconv_sched_calc() with the brute-force
+*        timeline simulation of the random configurations. See tools/README.md for the usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_sched.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* The maximal simulated period, PWM clock cycles */
+#define PERIOD_MAX          (64U)
+
+/* The overlapping ISRs mark in the pair tables */
+#define OVERLAP             (-1)
+
+/* The check options */
+typedef struct
+{
+    uint32_t num;                                /* The number of the random configurations */
+    uint32_t inst;                               /* The maximal number of the instances */
+    uint32_t pmax;                               /* The maximal period, PWM clock cycles */
+    uint32_t dmax;                               /* The maximal decimation factor */
+    unsigned seed;
+    bool     verbose;
+} check_t;
+
+/* The minimal idle gap between the ISRs of every two instances at every two phases, or OVERLAP */
+static int32_t pairGap[MTB_PWRCONV_SCHED_MAX][MTB_PWRCONV_SCHED_MAX][PERIOD_MAX][PERIOD_MAX];
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -n num             the number of the random configurations, 1000 by default\n"
+        "  -i num             the maximal number of the instances, 2..%u, 3 by default\n"
+        "  -p cycles          the maximal period, PWM clock cycles, 4..%u, 24 by default\n"
+        "  -d div             the maximal decimation factor, 3 by default\n"
+        "  -s seed            the random seed\n"
+        "  -v                 print every configuration\n", name, MTB_PWRCONV_SCHED_MAX, PERIOD_MAX);
+}
+
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    return (0U == b) ? a : gcd(b, a % b);
+}
+
+
+/* The random value in the min..max range */
+static uint32_t rnd(uint32_t min, uint32_t max)
+{
+    return min + ((uint32_t)rand() % (max - min + 1U));
+}
+
+
+static void print(mtb_stc_pwrconv_sched_t const task[], uint32_t num)
+{
+    for (uint32_t i = 0U; i < num; i++)
+    {
+        (void)printf("  period %u wcet %u light %u div %u delay %u phase %u\n", task[i].period, task[i].wcet,
+                     task[i].light, task[i].div, task[i].delay, task[i].phase);
+    }
+}
+
+
+/* Simulates the ISRs of the instances on the timeline as they run on the target: every PWM counter starts
+ * from its phase synchronously, the ISR is triggered delay after every period start and executes the regulator
+ * in every div-th period after the start. Returns the minimal idle gap between the ISRs of different instances
+ * in the steady state or OVERLAP.
+ */
+static int32_t simulate(mtb_stc_pwrconv_sched_t const * const task[], uint32_t const phase[], uint32_t num)
+{
+    uint32_t hyper = 1U;
+    uint32_t warm = 0U;
+    uint32_t len;
+    uint32_t lastEnd = 0U;
+    uint8_t lastOwner = 0U;
+    int32_t gap = INT32_MAX;
+    uint8_t * line;
+
+    for (uint32_t i = 0U; i < num; i++)
+    {
+        uint32_t period = task[i]->period * ((1U < task[i]->div) ? task[i]->div : 1U);
+
+        hyper = (hyper / gcd(hyper, period)) * period;
+        warm = (period > warm) ? period : warm;
+    }
+
+    /* All the instances reach the steady state within the first warm cycles, then the timeline repeats */
+    warm *= 2U;
+    len = warm + hyper + PERIOD_MAX;
+    line = calloc(len, 1U);
+    if (NULL == line)
+    {
+        (void)fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (uint32_t i = 0U; (OVERLAP != gap) && (i < num); i++)
+    {
+        bool dec = (1U < task[i]->div);
+        uint32_t start = (task[i]->delay + task[i]->period - phase[i]) % task[i]->period;
+
+        for (uint32_t n = 1U; (OVERLAP != gap) && (start < len); n++)
+        {
+            uint32_t end = start + ((dec && (0U != (n % task[i]->div))) ? task[i]->light : task[i]->wcet);
+
+            for (uint32_t t = start; (t < end) && (t < len); t++)
+            {
+                gap = (0U != line[t]) ? OVERLAP : gap;
+                line[t] = (uint8_t)(i + 1U);
+            }
+            start += task[i]->period;
+        }
+    }
+
+    for (uint32_t t = warm / 2U; (OVERLAP != gap) && (t < len); t++)
+    {
+        uint8_t owner = line[t];
+
+        /* The gap from the last ISR of another instance to the ISR starting in the steady state window */
+        if ((0U != owner) && (owner != line[t - 1U]) && (t >= warm) && (t < (warm + hyper)) &&
+            (0U != lastOwner) && (owner != lastOwner) && ((int32_t)(t - lastEnd) < gap))
+        {
+            gap = (int32_t)(t - lastEnd);
+        }
+        if ((0U != owner) && (((t + 1U) == len) || (owner != line[t + 1U])))
+        {
+            lastOwner = owner;
+            lastEnd = t + 1U;
+        }
+    }
+
+    free(line);
+
+    return gap;
+}
+
+
+/* Fills the pair tables by the simulation of every two instances at all their phases */
+static void pair_tables(mtb_stc_pwrconv_sched_t const task[], uint32_t num)
+{
+    for (uint32_t i = 0U; i < num; i++)
+    {
+        for (uint32_t j = i + 1U; j < num; j++)
+        {
+            mtb_stc_pwrconv_sched_t const * pair[2] = { &task[i], &task[j] };
+            uint32_t phase[2];
+
+            for (phase[0] = 0U; phase[0] < task[i].period; phase[0]++)
+            {
+                for (phase[1] = 0U; phase[1] < task[j].period; phase[1]++)
+                {
+                    pairGap[i][j][phase[0]][phase[1]] = simulate(pair, phase, 2U);
+                }
+            }
+        }
+    }
+}
+
+
+/* Searches all the phases of the instances from idx on, returns the largest minimal gap or OVERLAP */
+static int32_t brute_force(mtb_stc_pwrconv_sched_t const task[], uint32_t num, uint32_t phase[], uint32_t idx,
+                           int32_t gap)
+{
+    int32_t best = OVERLAP;
+
+    if (idx == num)
+    {
+        best = gap;
+    }
+    else
+    {
+        for (phase[idx] = 0U; phase[idx] < task[idx].period; phase[idx]++)
+        {
+            int32_t min = gap;
+
+            for (uint32_t i = 0U; (OVERLAP != min) && (i < idx); i++)
+            {
+                int32_t pg = pairGap[i][idx][phase[i]][phase[idx]];
+                min = (pg < min) ? pg : min;
+            }
+            if ((OVERLAP != min) && (min > best))
+            {
+                min = brute_force(task, num, phase, idx + 1U, min);
+                best = (min > best) ? min : best;
+            }
+        }
+    }
+
+    return best;
+}
+
+
+/* The random configuration: the periods are mostly the multiples of a common base to be schedulable,
+ * the execution times leave room for all the instances only sometimes
+ */
+static uint32_t generate(check_t const * ck, mtb_stc_pwrconv_sched_t task[])
+{
+    uint32_t num = rnd(2U, ck->inst);
+    uint32_t base = rnd(2U, ck->pmax / 3U);
+
+    for (uint32_t i = 0U; i < num; i++)
+    {
+        mtb_stc_pwrconv_sched_t * t = &task[i];
+
+        t->period = (0U != rnd(0U, 3U)) ? (base * rnd(1U, 3U)) : rnd(2U, ck->pmax);
+        t->wcet = rnd(1U, (t->period + num - 1U) / num);
+        t->div = (0U != rnd(0U, 1U)) ? rnd(0U, ck->dmax) : 0U;
+        t->light = (1U < t->div) ? rnd(1U, t->wcet) : 0U;
+        t->delay = rnd(0U, t->period - 1U);
+        t->phase = 0U;
+    }
+
+    return num;
+}
+
+
+int main(int argc, char * argv[])
+{
+    check_t ck = { 1000U, 3U, 24U, 3U, 1U, false };
+    mtb_stc_pwrconv_sched_t task[MTB_PWRCONV_SCHED_MAX];
+    mtb_stc_pwrconv_sched_t const * all[MTB_PWRCONV_SCHED_MAX];
+    uint32_t phase[MTB_PWRCONV_SCHED_MAX];
+    uint32_t found = 0U;
+    uint32_t none = 0U;
+    uint32_t fail = 0U;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "n:i:p:d:s:v")))
+    {
+        switch (opt)
+        {
+            case 'n': ck.num = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': ck.inst = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': ck.pmax = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': ck.dmax = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': ck.seed = (unsigned)strtoul(optarg, NULL, 0); break;
+            case 'v': ck.verbose = true; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+    if ((2U > ck.inst) || (MTB_PWRCONV_SCHED_MAX < ck.inst) || (6U > ck.pmax) || (PERIOD_MAX < ck.pmax))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    srand(ck.seed);
+
+    for (uint32_t k = 0U; k < ck.num; k++)
+    {
+        uint32_t num = generate(&ck, task);
+        int32_t best;
+        int32_t gap = OVERLAP;
+        cy_rslt_t rslt;
+
+        pair_tables(task, num);
+        best = brute_force(task, num, phase, 0U, INT32_MAX);
+        rslt = mtb_pwrconv_sched_calc(task, num);
+
+        if (MTB_PWRCONV_RSLT_SUCCESS == rslt)
+        {
+            for (uint32_t i = 0U; i < num; i++)
+            {
+                all[i] = &task[i];
+                phase[i] = task[i].phase;
+            }
+            gap = simulate(all, phase, num);
+            found++;
+        }
+        else
+        {
+            none++;
+        }
+
+        if (ck.verbose)
+        {
+            (void)printf("%u: %s, the gap %d, the largest gap %d\n", k,
+                         (MTB_PWRCONV_RSLT_SUCCESS == rslt) ? "scheduled" : "no schedule", gap, best);
+            print(task, num);
+        }
+        if ((MTB_PWRCONV_RSLT_SUCCESS != rslt) && (MTB_PWRCONV_RSLT_NO_SCHEDULE != rslt))
+        {
+            (void)printf("FAIL: configuration %u is rejected as invalid\n", k);
+            print(task, num);
+            fail++;
+        }
+        else if ((MTB_PWRCONV_RSLT_NO_SCHEDULE == rslt) && (OVERLAP != best))
+        {
+            (void)printf("FAIL: configuration %u has no schedule, but the gap %d is possible\n", k, best);
+            print(task, num);
+            fail++;
+        }
+        else if ((MTB_PWRCONV_RSLT_SUCCESS == rslt) && (OVERLAP == gap))
+        {
+            (void)printf("FAIL: configuration %u ISRs overlap at the calculated phases\n", k);
+            print(task, num);
+            fail++;
+        }
+        else if ((MTB_PWRCONV_RSLT_SUCCESS == rslt) && (gap != best))
+        {
+            (void)printf("FAIL: configuration %u gap %d, while the gap %d is possible\n", k, gap, best);
+            print(task, num);
+            fail++;
+        }
+        else
+        {
+            /* The scheduler agrees with the simulation */
+        }
+    }
+
+    (void)printf("%u configurations: %u scheduled, %u without a schedule\n", ck.num, found, none);
+    if (0U == fail)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return (0U == fail) ? EXIT_SUCCESS : 2;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,216 @@
+/***************************************************************************//**
+* \file trace_record.c
+* \version 1.0
+* \brief The host (PC) recording of the control loop trace against the power stage model,
+*        the reference trace for the trace_replay tool. See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_trace.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "plant_model.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TRACE_SIZE_MAX      (65536U)
+#define FEEDBACK_K          (1e-3)      /* The feedback volts per ADC count */
+#define PWM_PERIOD          (1000.0)    /* The PWM period, counts */
+#define SAMPL_FREQ          (250000UL)  /* The control loop sampling frequency, Hz */
+#define CHAN_EVERY          (10U)       /* The scheduled channel period, cycles */
+
+/* The event codes */
+#define EVT_TRIG            (1UL)       /* The triggering event, overwritten by the next one before recorded */
+#define EVT_NEXT            (2UL)
+#define EVT_FAULT           (3UL)       /* Posted just before the disabling */
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options] -o <trace file>\n"
+        "  -b b0,b1,b2        the regulator numerator coefficients, 0.02,-0.0195,0 by default\n"
+        "  -a a1,a2           the regulator denominator coefficients, 1,0 by default\n"
+        "  -l min,max         the regulator output limits, 0,1000 by default\n"
+        "  -n cycles          the control loop cycles before the trigger, 20000 by default\n"
+        "  -d cycles          the control loop cycles between the trigger and the disabling, 100 by default\n"
+        "  -s size            the trace buffer size, records, a power of two, 4096 by default\n"
+        "  -p post            the post-trigger records, 1024 by default\n", name);
+}
+
+
+int main(int argc, char * argv[])
+{
+    static mtb_stc_pwrconv_trace_rec_t buf[TRACE_SIZE_MAX];
+    static mtb_stc_pwrconv_trace_ctx_t trace;
+    static mtb_stc_pwrconv_reg_2p2z_float_ctx_t reg;
+    mtb_stc_pwrconv_reg_2p2z_float_cfg_t cfg = { { 0.0f, 1.0f, 0.0f }, { 0.02f, -0.0195f, 0.0f }, 0.0f, 1000.0f };
+    mtb_stc_pwrconv_trace_cfg_t traceCfg = { buf, 4096UL, 1024UL, SAMPL_FREQ };
+    mtb_stc_pwrconv_trace_hdr_t hdr;
+    mtb_stc_pwrconv_ctx_t ctx;
+    plant_buck_t plant;
+    double list[3];
+    char const * name = NULL;
+    FILE * out;
+    uint32_t cycles = 20000U;
+    uint32_t dis = 100U;
+    uint32_t trigState;
+    uint32_t last;
+    int rslt = EXIT_SUCCESS;
+    int opt;
+
+    while (-1 != (opt = getopt(argc, argv, "b:a:l:n:d:s:p:o:")))
+    {
+        switch (opt)
+        {
+            case 'b':
+                if (3 == tool_parse_list(optarg, list, 3))
+                {
+                    cfg.b[0] = (float32_t)list[0];
+                    cfg.b[1] = (float32_t)list[1];
+                    cfg.b[2] = (float32_t)list[2];
+                }
+                break;
+            case 'a':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    cfg.a[1] = (float32_t)list[0];
+                    cfg.a[2] = (float32_t)list[1];
+                }
+                break;
+            case 'l':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    cfg.min = (float32_t)list[0];
+                    cfg.max = (float32_t)list[1];
+                }
+                break;
+            case 'n': cycles = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': dis = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': traceCfg.size = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'p': traceCfg.post = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o': name = optarg; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((NULL == name) || (traceCfg.size > TRACE_SIZE_MAX) ||
+        (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_trace_init(&trace, &traceCfg)))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    (void)mtb_pwrconv_2p2z_float_init(&reg, &cfg);
+    (void)memset(&ctx, 0, sizeof(ctx));
+    plant_buck_init(&plant, 2.2e-6, 200e-6, 10e-3, 5e-3, 12.0, 1.0 / (double)SAMPL_FREQ);
+    plant.rload = 1.0;
+
+    /* The generated control loop ISR: the feedback, the error, the regulator and the trace,
+     * the reference ramps to 3.3 V, the load steps before the trigger, so the trace holds the transient
+     */
+    for (uint32_t n = 0U; n < (cycles + dis); n++)
+    {
+        plant_buck_step_vcm(&plant, (double)ctx.mod / PWM_PERIOD, false);
+        ctx.ref = (n < 3300U) ? n : 3300U;
+        plant.iload = ((n + 500U) < cycles) ? 0.0 : 5.0;
+        ctx.res = plant_adc(plant_buck_vout(&plant), FEEDBACK_K, 4095U);
+        (void)mtb_pwrconv_get_error(&ctx);
+        (void)mtb_pwrconv_2p2z_float_process(&reg, ctx.err, &ctx.mod);
+        mtb_pwrconv_trace_cycle(&trace, &ctx);
+
+        if (0U == (n % CHAN_EVERY))
+        {
+            /* The scheduled ADC group callback */
+            mtb_pwrconv_trace_chan(&trace, 0UL, plant_adc(plant_buck_iout(&plant), 1e-2, 4095U));
+        }
+        if (n == cycles)
+        {
+            /* The trigger request is not lost when the event is overwritten before the next cycle */
+            mtb_pwrconv_trace_event(&trace, EVT_TRIG, n, true);
+            mtb_pwrconv_trace_event(&trace, EVT_NEXT, n, false);
+        }
+    }
+    trigState = mtb_pwrconv_trace_get_state(&trace);
+
+    /* The protection handler: the fault event and the generated myPwrConv_disable() */
+    mtb_pwrconv_trace_event(&trace, EVT_FAULT, 0UL, false);
+    mtb_pwrconv_trace_stop(&trace);
+
+    mtb_pwrconv_trace_get_header(&trace, &hdr);
+    last = (0UL != hdr.num) ? mtb_pwrconv_trace_get_rec(&trace, hdr.num - 1UL)->tag : 0UL;
+    (void)printf("records: %u, cycles: %u, state at the disabling: %u\n", hdr.num, cycles + dis, trigState);
+    if (MTB_PWRCONV_TRACE_RUN == trigState)
+    {
+        (void)printf("FAIL: the overwritten trigger event did not trigger the trace\n");
+        rslt = 2;
+    }
+    if (MTB_PWRCONV_TRACE_STOP != mtb_pwrconv_trace_get_state(&trace))
+    {
+        (void)printf("FAIL: the trace is not stopped by the disabling\n");
+        rslt = 2;
+    }
+    if ((MTB_PWRCONV_TRACE_TRIG == trigState) &&
+        ((MTB_PWRCONV_TRACE_EVENT != ((last & MTB_PWRCONV_TRACE_TYPE_Msk) >> MTB_PWRCONV_TRACE_TYPE_Pos)) ||
+         (EVT_FAULT != ((last & MTB_PWRCONV_TRACE_ID_Msk) >> MTB_PWRCONV_TRACE_ID_Pos))))
+    {
+        (void)printf("FAIL: the fault event posted before the disabling is not recorded\n");
+        rslt = 2;
+    }
+
+    out = fopen(name, "wb");
+    if (NULL == out)
+    {
+        (void)fprintf(stderr, "Can't write %s\n", name);
+        return EXIT_FAILURE;
+    }
+    (void)fwrite(&hdr, sizeof(hdr), 1U, out);
+    for (uint32_t idx = 0UL; idx < hdr.num; idx++)
+    {
+        (void)fwrite(mtb_pwrconv_trace_get_rec(&trace, idx), sizeof(mtb_stc_pwrconv_trace_rec_t), 1U, out);
+    }
+    (void)fclose(out);
+
+    (void)printf("%s\n", (EXIT_SUCCESS == rslt) ? "PASS" : "FAIL");
+
+    return rslt;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,375 @@
+/***************************************************************************//**
+* \file trace_replay.c
+* \version 1.0
+* \brief The host (PC) tool replaying the recorded control loop trace through the regulator.
+*        See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_trace.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_3p3z_float.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* The replay options and state */
+typedef struct
+{
+    bool     reg3;                               /* 3P3Z regulator, 2P2Z otherwise */
+    float32_t a[4];
+    float32_t b[4];
+    float32_t min;
+    float32_t max;
+    uint32_t tol;                                /* The tolerated modulator difference, counts */
+    FILE   * out;                                /* The optional per-cycle CSV output */
+    mtb_stc_pwrconv_ctx_t               ctx;
+    mtb_stc_pwrconv_reg_2p2z_float_ctx_t reg2;
+    mtb_stc_pwrconv_reg_3p3z_float_ctx_t reg3Ctx;
+    uint64_t cycle;                              /* The unwrapped cycle number */
+    uint32_t lastTick;
+    uint64_t cycles;
+    uint64_t warm;                               /* The remaining warm-up cycles */
+    bool     refKnown;                           /* The cycles are skipped until the first reference record */
+    uint64_t skipped;
+    uint64_t events;
+    uint64_t chans;
+    uint64_t mismatches;
+    uint64_t firstMismatch;
+    uint32_t maxDiff;
+} replay_t;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options] <trace file>\n"
+        "  -r 2p2z|3p3z       the regulator type, 2p2z by default\n"
+        "  -b b0,b1,b2[,b3]   the regulator numerator coefficients (myPwrConv_regCfg.b)\n"
+        "  -a a1,a2[,a3]      the regulator denominator coefficients (myPwrConv_regCfg.a[1..])\n"
+        "  -l min,max         the regulator output limits (myPwrConv_regCfg.min/max)\n"
+        "  -t tol             the tolerated modulator difference, counts, 1 by default\n"
+        "  -o file.csv        write the replayed cycles: cycle,ref,res,err,mod,recorded mod\n", name);
+}
+
+
+static int parse_list(char const * str, float32_t * dst, int max)
+{
+    double val[4];
+    int num = tool_parse_list(str, val, (max < 4) ? max : 4);
+
+    for (int i = 0; i < num; i++)
+    {
+        dst[i] = (float32_t)val[i];
+    }
+
+    return num;
+}
+
+
+/* Shifts the regulator history without the calculation - the regulator state is unknown at the trace start,
+ * so the first cycles are used to preload it by the recorded error and modulator values.
+ */
+static void warm_input(replay_t * rp, int32_t err)
+{
+    float32_t * i = rp->reg3 ? rp->reg3Ctx.dat.i : rp->reg2.dat.i;
+    int n = rp->reg3 ? 3 : 2;
+
+    for (int k = n - 1; k > 0; k--)
+    {
+        i[k] = i[k - 1];
+    }
+    i[0] = (float32_t)err;
+}
+
+
+static void warm_output(replay_t * rp, uint32_t mod)
+{
+    float32_t * o = rp->reg3 ? rp->reg3Ctx.dat.o : rp->reg2.dat.o;
+    int n = rp->reg3 ? 3 : 2;
+
+    for (int k = n - 1; k > 0; k--)
+    {
+        o[k] = o[k - 1];
+    }
+    o[0] = (float32_t)mod;
+}
+
+
+static void replay_rec(replay_t * rp, mtb_stc_pwrconv_trace_rec_t const * rec)
+{
+    uint32_t tick = rec->tag & MTB_PWRCONV_TRACE_TICK_Msk;
+    uint32_t type = (rec->tag & MTB_PWRCONV_TRACE_TYPE_Msk) >> MTB_PWRCONV_TRACE_TYPE_Pos;
+    uint32_t id   = (rec->tag & MTB_PWRCONV_TRACE_ID_Msk) >> MTB_PWRCONV_TRACE_ID_Pos;
+
+    /* Unwrapping the cycle counter */
+    rp->cycle += (tick - rp->lastTick) & MTB_PWRCONV_TRACE_TICK_Msk;
+    rp->lastTick = tick;
+
+    switch (type)
+    {
+        case MTB_PWRCONV_TRACE_REF:
+            rp->ctx.ref = rec->val;
+            rp->refKnown = true;
+            break;
+
+        case MTB_PWRCONV_TRACE_RES:
+            if (!rp->refKnown)
+            {
+                break;
+            }
+            rp->ctx.res = rec->val;
+            (void)mtb_pwrconv_get_error(&rp->ctx); /* The same path as in the generated ISR */
+            if (0U != rp->warm)
+            {
+                warm_input(rp, rp->ctx.err);
+            }
+            else if (rp->reg3)
+            {
+                (void)mtb_pwrconv_3p3z_float_process(&rp->reg3Ctx, rp->ctx.err, &rp->ctx.mod);
+            }
+            else
+            {
+                (void)mtb_pwrconv_2p2z_float_process(&rp->reg2, rp->ctx.err, &rp->ctx.mod);
+            }
+            break;
+
+        case MTB_PWRCONV_TRACE_MOD:
+            if (!rp->refKnown)
+            {
+                rp->skipped++;
+                break;
+            }
+            if (0U != rp->warm)
+            {
+                warm_output(rp, rec->val);
+                rp->ctx.mod = rec->val;
+                rp->warm--;
+            }
+            else
+            {
+                uint32_t diff = (rp->ctx.mod > rec->val) ? (rp->ctx.mod - rec->val) : (rec->val - rp->ctx.mod);
+
+                if (diff > rp->maxDiff)
+                {
+                    rp->maxDiff = diff;
+                }
+                if (diff > rp->tol)
+                {
+                    if (0U == rp->mismatches)
+                    {
+                        rp->firstMismatch = rp->cycle;
+                    }
+                    rp->mismatches++;
+                }
+                if (NULL != rp->out)
+                {
+                    (void)fprintf(rp->out, "%llu,%u,%u,%d,%u,%u\n", (unsigned long long)rp->cycle,
+                                  rp->ctx.ref, rp->ctx.res, rp->ctx.err, rp->ctx.mod, rec->val);
+                }
+            }
+            rp->cycles++;
+            break;
+
+        case MTB_PWRCONV_TRACE_CHAN:
+            rp->chans++;
+            break;
+
+        case MTB_PWRCONV_TRACE_EVENT:
+            rp->events++;
+            (void)printf("event %u (0x%08x) at cycle %llu\n", id, rec->val, (unsigned long long)rp->cycle);
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+int main(int argc, char * argv[])
+{
+    static replay_t rp;
+    mtb_stc_pwrconv_trace_hdr_t const * hdr;
+    mtb_stc_pwrconv_trace_rec_t const * rec;
+    char const * outName = NULL;
+    float32_t lim[2] = { 0.0f, 65535.0f };
+    int numA = 0;
+    int numB = 0;
+    int opt;
+    int fd;
+    struct stat st;
+    void * map;
+    struct timespec t0;
+    struct timespec t1;
+    double sec;
+
+    rp.tol = 1U;
+    while (-1 != (opt = getopt(argc, argv, "r:b:a:l:t:o:")))
+    {
+        switch (opt)
+        {
+            case 'r':
+                if (0 == strcmp(optarg, "2p2z"))
+                {
+                    rp.reg3 = false;
+                }
+                else if (0 == strcmp(optarg, "3p3z"))
+                {
+                    rp.reg3 = true;
+                }
+                else
+                {
+                    /* The predictive regulator state depends on the observer, it is not recorded */
+                    (void)fprintf(stderr, "The %s regulator is not replayed, only 2p2z and 3p3z\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'b': numB = parse_list(optarg, rp.b, 4); break;
+            case 'a': numA = parse_list(optarg, &rp.a[1], 3); break;
+            case 'l': (void)parse_list(optarg, lim, 2); break;
+            case 't': rp.tol = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'o': outName = optarg; break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((optind >= argc) || (numB != (rp.reg3 ? 4 : 3)) || (numA != (rp.reg3 ? 3 : 2)))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* The trace is memory-mapped, so its size is limited by the address space only */
+    fd = open(argv[optind], O_RDONLY);
+    if ((fd < 0) || (0 != fstat(fd, &st)) || ((size_t)st.st_size < sizeof(*hdr)))
+    {
+        (void)fprintf(stderr, "Can't read %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == map)
+    {
+        (void)fprintf(stderr, "Can't map %s\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    (void)posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+
+    hdr = (mtb_stc_pwrconv_trace_hdr_t const *)map;
+    if ((MTB_PWRCONV_TRACE_MAGIC != hdr->magic) || (MTB_PWRCONV_TRACE_VERSION != hdr->version) ||
+        (sizeof(*rec) != hdr->recSize) ||
+        (((size_t)st.st_size - sizeof(*hdr)) / sizeof(*rec) < hdr->num))
+    {
+        (void)fprintf(stderr, "%s is not a valid trace file\n", argv[optind]);
+        return EXIT_FAILURE;
+    }
+    rec = (mtb_stc_pwrconv_trace_rec_t const *)(hdr + 1);
+
+    if (NULL != outName)
+    {
+        rp.out = fopen(outName, "w");
+        if (NULL == rp.out)
+        {
+            (void)fprintf(stderr, "Can't write %s\n", outName);
+            return EXIT_FAILURE;
+        }
+        (void)fprintf(rp.out, "cycle,ref,res,err,mod,rec_mod\n");
+    }
+
+    if (rp.reg3)
+    {
+        mtb_stc_pwrconv_reg_3p3z_float_cfg_t cfg;
+        (void)memcpy(cfg.a, rp.a, sizeof(cfg.a));
+        (void)memcpy(cfg.b, rp.b, sizeof(cfg.b));
+        cfg.min = lim[0];
+        cfg.max = lim[1];
+        (void)mtb_pwrconv_3p3z_float_init(&rp.reg3Ctx, &cfg);
+        rp.warm = 3U;
+    }
+    else
+    {
+        mtb_stc_pwrconv_reg_2p2z_float_cfg_t cfg;
+        (void)memcpy(cfg.a, rp.a, sizeof(cfg.a));
+        (void)memcpy(cfg.b, rp.b, sizeof(cfg.b));
+        cfg.min = lim[0];
+        cfg.max = lim[1];
+        (void)mtb_pwrconv_2p2z_float_init(&rp.reg2, &cfg);
+        rp.warm = 2U;
+    }
+    rp.lastTick = (0U != hdr->num) ? (rec[0].tag & MTB_PWRCONV_TRACE_TICK_Msk) : 0U;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (uint32_t idx = 0U; idx < hdr->num; idx++)
+    {
+        replay_rec(&rp, &rec[idx]);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &t1);
+    sec = (double)(t1.tv_sec - t0.tv_sec) + (1e-9 * (double)(t1.tv_nsec - t0.tv_nsec));
+
+    (void)printf("records: %u, cycles: %llu (%llu skipped before the reference), channel samples: %llu, events: %llu\n",
+                 hdr->num, (unsigned long long)rp.cycles, (unsigned long long)rp.skipped,
+                 (unsigned long long)rp.chans, (unsigned long long)rp.events);
+    (void)printf("modulator mismatches above %u: %llu", rp.tol, (unsigned long long)rp.mismatches);
+    if (0U != rp.mismatches)
+    {
+        (void)printf(", the first at cycle %llu", (unsigned long long)rp.firstMismatch);
+    }
+    (void)printf(", max difference: %u\n", rp.maxDiff);
+    if ((0.0 < sec) && (0U != hdr->freq))
+    {
+        (void)printf("replayed in %.3f s, %.1f times faster than real time\n", sec,
+                     ((double)rp.cycles / (double)hdr->freq) / sec);
+    }
+
+    if (NULL != rp.out)
+    {
+        (void)fclose(rp.out);
+    }
+    (void)munmap(map, (size_t)st.st_size);
+    (void)close(fd);
+
+    return (0U == rp.mismatches) ? EXIT_SUCCESS : 2;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,293 @@
+/***************************************************************************//**
+* \file tune_check.c
+* \version 1.0
+* \brief The host (PC) check of the relay auto-tuning against the power stage model.
+*        See tools/README.md for the build and usage.
+********************************************************************************
+* \copyright
+* (c) (2024), Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation. All rights reserved.
+********************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation or one of its
+* affiliates ("Cypress") and is protected by and subject to worldwide patent
+* protection (United States and foreign), United States copyright laws and
+* international treaty provisions. Therefore, you may use this Software only
+* as provided in the license agreement accompanying the software package from
+* which you obtained this Software ("EULA").
+*
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software source
+* code solely for use in connection with Cypress's integrated circuit products.
+* Any reproduction, modification, translation, compilation, or representation
+* of this Software except as specified above is prohibited without the express
+* written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer of such
+* system or application assumes all risk of such use and in doing so agrees to
+* indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mtb_pwrconv.h"
+#include "mtb_pwrconv_2p2z_float.h"
+#include "mtb_pwrconv_tune_float.h"
+#include "plant_model.h"
+#include "tool_args.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+/* The check options */
+typedef struct
+{
+    double   l;                                  /* H */
+    double   c;                                  /* F */
+    double   rl;                                 /* Ohm */
+    double   rc;                                 /* Ohm */
+    double   vin;                                /* V */
+    double   vout;                               /* V */
+    double   fs;                                 /* The control loop sampling frequency, Hz */
+    double   period;                             /* The PWM period, counts */
+    double   k;                                  /* The feedback volts per count */
+    double   load[2];                            /* The load step, A */
+    uint32_t extra;                              /* The relay periods after the measurement completion */
+    double   tol;                                /* The tolerated steady-state error, counts */
+    mtb_stc_pwrconv_tune_float_cfg_t cfg;
+    FILE   * out;
+} check_t;
+
+
+static void usage(char const * name)
+{
+    (void)fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  -L uH,-C uF        the total inductance and the output capacitance\n"
+        "  -r mOhm,-R mOhm    the inductor and the capacitor ESR\n"
+        "  -v Vin,Vout        the input and output voltages\n"
+        "  -f Hz              the control loop sampling frequency (SamplFreq)\n"
+        "  -p counts          the PWM period\n"
+        "  -k V               the feedback volts per ADC count\n"
+        "  -a counts,hyst     the relay amplitude (modulator counts) and hysteresis (ADC counts)\n"
+        "  -m skip,periods    the relay settling and measured periods\n"
+        "  -x periods         the relay periods between the measurement completion and the coefficients\n"
+        "                     calculation, 10 by default\n"
+        "  -i i0,i1           the load step applied to the tuned regulator, A\n"
+        "  -t counts          the tolerated steady-state error of the tuned regulator\n"
+        "  -o file.csv        write the periods: n,vout,res,err,mod\n", name);
+}
+
+
+/* Runs one control loop period: the plant, the feedback, the error */
+static int32_t period(check_t const * ck, plant_buck_t * plant, mtb_stc_pwrconv_ctx_t * ctx, uint32_t n)
+{
+    plant_buck_step_vcm(plant, (double)ctx->mod / ck->period, false);
+    ctx->res = plant_adc(plant_buck_vout(plant), ck->k, UINT32_MAX);
+    (void)mtb_pwrconv_get_error(ctx);
+    if (NULL != ck->out)
+    {
+        (void)fprintf(ck->out, "%u,%g,%u,%d,%u\n", n, plant_buck_vout(plant), ctx->res, ctx->err, ctx->mod);
+    }
+
+    return ctx->err;
+}
+
+
+int main(int argc, char * argv[])
+{
+    static check_t ck;
+    static mtb_stc_pwrconv_tune_float_ctx_t tune;
+    static mtb_stc_pwrconv_reg_2p2z_float_ctx_t reg;
+    mtb_stc_pwrconv_reg_2p2z_float_cfg_t first;
+    mtb_stc_pwrconv_reg_2p2z_float_cfg_t later;
+    mtb_stc_pwrconv_ctx_t ctx;
+    plant_buck_t plant;
+    double list[2];
+    double tu;
+    double amp;
+    uint32_t n = 0U;
+    uint32_t done;
+    uint32_t num;
+    int32_t errMax = INT32_MIN;
+    int32_t errMin = INT32_MAX;
+    int rslt = EXIT_SUCCESS;
+    int opt;
+
+    ck.l = 2.2e-6;
+    ck.c = 200e-6;
+    ck.rl = 10e-3;
+    ck.rc = 5e-3;
+    ck.vin = 12.0;
+    ck.vout = 3.3;
+    ck.fs = 250e3;
+    ck.period = 1000.0;
+    ck.k = 1e-3;
+    ck.load[0] = 2.0;
+    ck.load[1] = 10.0;
+    ck.extra = 10U;
+    ck.tol = 2.0;
+    ck.cfg.amp = 20.0f;
+    ck.cfg.hyst = 7;
+    ck.cfg.skip = 3UL;
+    ck.cfg.periods = 4UL;
+    ck.cfg.kp = MTB_PWRCONV_TUNE_ZN_KP;
+    ck.cfg.ti = MTB_PWRCONV_TUNE_ZN_TI;
+    ck.cfg.td = MTB_PWRCONV_TUNE_ZN_TD;
+    ck.cfg.n = 10.0f;
+    while (-1 != (opt = getopt(argc, argv, "L:C:r:R:v:f:p:k:a:m:x:i:t:o:")))
+    {
+        switch (opt)
+        {
+            case 'L': ck.l = strtod(optarg, NULL) * 1e-6; break;
+            case 'C': ck.c = strtod(optarg, NULL) * 1e-6; break;
+            case 'r': ck.rl = strtod(optarg, NULL) * 1e-3; break;
+            case 'R': ck.rc = strtod(optarg, NULL) * 1e-3; break;
+            case 'v':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.vin = list[0];
+                    ck.vout = list[1];
+                }
+                break;
+            case 'f': ck.fs = strtod(optarg, NULL); break;
+            case 'p': ck.period = strtod(optarg, NULL); break;
+            case 'k': ck.k = strtod(optarg, NULL); break;
+            case 'a':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.cfg.amp = (float32_t)list[0];
+                    ck.cfg.hyst = (int32_t)list[1];
+                }
+                break;
+            case 'm':
+                if (2 == tool_parse_list(optarg, list, 2))
+                {
+                    ck.cfg.skip = (uint32_t)list[0];
+                    ck.cfg.periods = (uint32_t)list[1];
+                }
+                break;
+            case 'x': ck.extra = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'i': (void)tool_parse_list(optarg, ck.load, 2); break;
+            case 't': ck.tol = strtod(optarg, NULL); break;
+            case 'o':
+                ck.out = fopen(optarg, "w");
+                if (NULL == ck.out)
+                {
+                    (void)fprintf(stderr, "Can't write %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default: usage(argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if ((ck.l <= 0.0) || (ck.c <= 0.0) || (ck.vin <= ck.vout) || (ck.vout <= 0.0) || (ck.fs <= 0.0) ||
+        (ck.period <= 0.0) || (ck.k <= 0.0) || (0UL == ck.cfg.periods))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    ck.cfg.min = 0.0f;
+    ck.cfg.max = (float32_t)ck.period;
+    ck.cfg.ts = (float32_t)(1.0 / ck.fs);
+    ck.cfg.timeout = (uint32_t)(0.1 * ck.fs);
+
+    /* The steady state at the first load */
+    plant_buck_init(&plant, ck.l, ck.c, ck.rl, ck.rc, ck.vin, 1.0 / ck.fs);
+    plant.iload = ck.load[0];
+    plant.il = ck.load[0];
+    plant.vc = ck.vout;
+    (void)memset(&ctx, 0, sizeof(ctx));
+    ctx.ref = plant_adc(ck.vout, ck.k, UINT32_MAX);
+    ctx.mod = (uint32_t)lround((ck.vout + (ck.rl * plant.il)) * ck.period / ck.vin);
+
+    /* The relay oscillation measurement */
+    if (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_tune_float_start(&tune, &ck.cfg, ctx.mod))
+    {
+        (void)printf("FAIL: the auto-tuning start\n");
+        return 2;
+    }
+    while (MTB_PWRCONV_TUNE_ACTIVE == mtb_pwrconv_tune_float_get_state(&tune))
+    {
+        (void)mtb_pwrconv_tune_float_process(&tune, period(&ck, &plant, &ctx, n++), &ctx.mod);
+    }
+    if (MTB_PWRCONV_RSLT_SUCCESS != mtb_pwrconv_tune_float_get_2p2z(&tune, &first))
+    {
+        (void)printf("FAIL: the relay oscillation is not measured, state %u\n",
+                     (unsigned)mtb_pwrconv_tune_float_get_state(&tune));
+        return 2;
+    }
+    tu = (double)tune.dat.perSum / (double)ck.cfg.periods;
+    amp = 0.5 * (double)tune.dat.ampSum / (double)ck.cfg.periods;
+    (void)printf("relay oscillation: period %g us, amplitude %g counts\n", 1e6 * tu / ck.fs, amp);
+
+    /* The application polls the state later, the relay keeps oscillating */
+    done = tune.dat.edges;
+    while (tune.dat.edges < (done + ck.extra))
+    {
+        (void)mtb_pwrconv_tune_float_process(&tune, period(&ck, &plant, &ctx, n++), &ctx.mod);
+    }
+    (void)mtb_pwrconv_tune_float_get_2p2z(&tune, &later);
+    (void)printf("b: %g, %g, %g  a: %g, %g\n", (double)first.b[0], (double)first.b[1], (double)first.b[2],
+                 (double)first.a[1], (double)first.a[2]);
+    if (0 != memcmp(&first, &later, sizeof(first)))
+    {
+        (void)printf("FAIL: the coefficients differ %u relay periods after the measurement completion\n", ck.extra);
+        rslt = 2;
+    }
+
+    /* The tuned regulator takes the control back from the relay, then the load step is applied */
+    reg.cfg = first;
+    reg.cfg.min = 0.0f;
+    reg.cfg.max = (float32_t)ck.period;
+    (void)mtb_pwrconv_2p2z_float_init(&reg, &reg.cfg);
+    reg.dat.o[0] = (float32_t)ctx.mod;
+    reg.dat.o[1] = (float32_t)ctx.mod;
+    mtb_pwrconv_tune_float_stop(&tune);
+    num = (uint32_t)(200.0 * tu);
+    for (uint32_t k = 0U; k < (2U * num); k++)
+    {
+        if (k == num)
+        {
+            plant.iload = ck.load[1];
+        }
+        (void)mtb_pwrconv_2p2z_float_process(&reg, period(&ck, &plant, &ctx, n++), &ctx.mod);
+        if (k >= ((2U * num) - (num / 4U)))
+        {
+            errMax = (ctx.err > errMax) ? ctx.err : errMax;
+            errMin = (ctx.err < errMin) ? ctx.err : errMin;
+        }
+    }
+    (void)printf("tuned regulator, load step %g -> %g A: the final error %d..%d counts\n",
+                 ck.load[0], ck.load[1], errMin, errMax);
+    if (((double)errMax > ck.tol) || ((double)errMin < -ck.tol))
+    {
+        (void)printf("FAIL: the tuned regulator does not settle within %g counts\n", ck.tol);
+        rslt = 2;
+    }
+    if (NULL != ck.out)
+    {
+        (void)fclose(ck.out);
+    }
+    if (EXIT_SUCCESS == rslt)
+    {
+        (void)printf("PASS\n");
+    }
+
+    return rslt;
+}
+
+/* [] END OF FILE */